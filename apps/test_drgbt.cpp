@@ -1,6 +1,49 @@
 #include "DRGBT.h"
 #include "ConfigurationReader.h"
 #include "CommonFunctions.h"
+#include "RealVectorSpace.h"
+#include <chrono>
+
+// Check validity of 'num_configs' random configurations among 'num_obstacles' random obstacles, with and without
+// broad-phase culling, and measure the time of 'isValid(q)' in both modes. Both modes must give the same result.
+void benchmarkBroadPhase(scenario::Scenario &scenario, const Eigen::Vector3f &obs_dim, size_t num_obstacles, size_t num_configs)
+{
+	const size_t broad_phase_threshold { RealVectorSpaceConfig::BROAD_PHASE_THRESHOLD };
+	std::shared_ptr<base::RealVectorSpace> ss { std::dynamic_pointer_cast<base::RealVectorSpace>(scenario.getStateSpace()) };
+	if (ss == nullptr)
+		return;
+
+	initRandomObstacles(num_obstacles, obs_dim, scenario);
+	std::vector<Eigen::VectorXf> configs {};
+	for (size_t i = 0; i < num_configs; i++)
+		configs.emplace_back(scenario.getStateSpace()->getRandomState()->getCoord());
+
+	std::vector<bool> valid(num_configs), valid_broad_phase(num_configs);
+	std::vector<float> times(2, 0);
+	for (size_t k = 0; k < 2; k++)
+	{
+		RealVectorSpaceConfig::BROAD_PHASE_THRESHOLD = k;	// 0 - check all obstacles, 1 - always use broad phase
+		std::vector<bool> &result { k == 0 ? valid : valid_broad_phase };
+		ss->isValid(configs.front());		// Obstacle snapshot is (re)built outside of timing
+		
+		std::chrono::steady_clock::time_point time_start { std::chrono::steady_clock::now() };
+		for (size_t i = 0; i < num_configs; i++)
+			result[i] = ss->isValid(configs[i]);
+		times[k] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - time_start).count() * 1e-3;
+	}
+	RealVectorSpaceConfig::BROAD_PHASE_THRESHOLD = broad_phase_threshold;
+
+	size_t num_different { 0 };
+	for (size_t i = 0; i < num_configs; i++)
+		num_different += (valid[i] != valid_broad_phase[i]);
+
+	LOG(INFO) << "Num. obstacles: " << num_obstacles << "\t Num. valid configurations: " 
+			  << std::count(valid.begin(), valid.end(), true) << " of " << num_configs;
+	LOG(INFO) << "\t Time of isValid(q) checking all obstacles: " << times[0] / num_configs << " [us]";
+	LOG(INFO) << "\t Time of isValid(q) using broad phase:      " << times[1] / num_configs << " [us]";
+	if (num_different > 0)
+		LOG(ERROR) << "\t Num. configurations with different result: " << num_different;
+}
 
 int main(int argc, char **argv)
 {
@@ -55,6 +98,12 @@ int main(int argc, char **argv)
         RGBMTStarConfig::TERMINATE_WHEN_PATH_IS_FOUND = true;
 	}
 
+	for (size_t num_obstacles : {10, 100, 1000})
+	{
+		scenario::Scenario scenario(scenario_file_path, project_path);
+		benchmarkBroadPhase(scenario, obs_dim, num_obstacles, 10000);
+	}
+
 	while (init_num_obs <= max_num_obs)
 	{
 		LOG(INFO) << "Number of obstacles " << init_num_obs << " of " << max_num_obs;
@@ -0,0 +1,202 @@
+#include "ConfigurationReader.h"
+#include "CommonFunctions.h"
+#include "RealVectorSpace.h"
+#include <chrono>
+
+// Check 'num_edges' random edges of length 'RRTConnectConfig::EPS_STEP' starting from valid configurations.
+// For each rejected edge, count the number of 'isValid(q)' calls until the first colliding configuration is found
+// using each check order, and measure the time of 'isValid(q1, q2)' using each check order.
+void benchmarkEdgeCheckOrder(const std::shared_ptr<base::StateSpace> ss, size_t num_edges)
+{
+	const size_t num_checks { RealVectorSpaceConfig::NUM_INTERPOLATION_VALIDITY_CHECKS };
+	const base::EdgeCheckOrder edge_check_order { RealVectorSpaceConfig::EDGE_CHECK_ORDER };
+	const std::vector<base::EdgeCheckOrder> orders { base::EdgeCheckOrder::Backward,
+													 base::EdgeCheckOrder::Forward,
+													 base::EdgeCheckOrder::Bisection };
+	std::vector<std::vector<float>> num_calls(orders.size());
+	std::vector<float> times(orders.size(), 0);
+	size_t num_rejected { 0 };
+
+	for (size_t i = 0; i < num_edges; )
+	{
+		std::shared_ptr<base::State> q1 { ss->getRandomState() };
+		if (!ss->isValid(q1))
+			continue;
+
+		std::shared_ptr<base::State> q2 { ss->interpolateEdge(q1, ss->getRandomState(), RRTConnectConfig::EPS_STEP) };
+		i++;
+
+		for (size_t j = 0; j < orders.size(); j++)
+		{
+			RealVectorSpaceConfig::EDGE_CHECK_ORDER = orders[j];
+			std::chrono::steady_clock::time_point time_start { std::chrono::steady_clock::now() };
+			ss->isValid(q1, q2);
+			times[j] += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - time_start).count() * 1e-3;
+		}
+
+		std::vector<bool> valid(num_checks + 1, true);	// Validity of each interpolated configuration
+		for (size_t k = 1; k <= num_checks; k++)
+			valid[k] = ss->isValid(ss->getNewState(q1->getCoord() + (q2->getCoord() - q1->getCoord()) * (float(k) / num_checks)));
+
+		if (std::find(valid.begin(), valid.end(), false) == valid.end())
+			continue;
+
+		num_rejected++;
+		for (size_t j = 0; j < orders.size(); j++)
+		{
+			std::vector<size_t> indices { base::RealVectorSpace::computeEdgeCheckOrder(num_checks, orders[j]) };
+			size_t num { 0 };
+			while (valid[indices[num++]]);
+			num_calls[j].emplace_back(num);
+		}
+	}
+	RealVectorSpaceConfig::EDGE_CHECK_ORDER = edge_check_order;
+
+	LOG(INFO) << "Num. rejected edges: " << num_rejected << " of " << num_edges;
+	for (size_t j = 0; j < orders.size(); j++)
+	{
+		LOG(INFO) << "Check order: " << orders[j];
+		LOG(INFO) << "\t Num. isValid(q) calls per rejected edge: " << getMean(num_calls[j]) << " +- " << getStd(num_calls[j]);
+		LOG(INFO) << "\t Time of isValid(q1, q2) per edge: " << times[j] / num_edges << " [us]";
+	}
+}
+
+// Check 'num_edges' random edges of length 'edge_length' starting from valid configurations, with and without certified 
+// edge validation, and measure the time of 'isValid(q1, q2)' including the distance computation for 'q1'.
+// Since certified parts of the edge are truly collision-free, both modes must give the same result.
+void benchmarkCertifiedEdgeValidation(const std::shared_ptr<base::StateSpace> ss, size_t num_edges, float edge_length)
+{
+	const bool certified_edge_validation { RealVectorSpaceConfig::CERTIFIED_EDGE_VALIDATION };
+	std::vector<float> times_discrete {}, times_certified {};
+	size_t num_rejected { 0 }, num_different { 0 };
+
+	for (size_t i = 0; i < num_edges; )
+	{
+		std::shared_ptr<base::State> q1 { ss->getRandomState() };
+		if (!ss->isValid(q1))
+			continue;
+
+		std::shared_ptr<base::State> q2 { ss->interpolateEdge(q1, ss->getRandomState(), edge_length) };
+		i++;
+		
+		RealVectorSpaceConfig::CERTIFIED_EDGE_VALIDATION = false;
+		std::chrono::steady_clock::time_point time_start { std::chrono::steady_clock::now() };
+		bool valid { ss->isValid(ss->getNewState(q1->getCoord()), ss->getNewState(q2->getCoord())) };
+		times_discrete.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - time_start).count() * 1e-3);
+
+		RealVectorSpaceConfig::CERTIFIED_EDGE_VALIDATION = true;
+		time_start = std::chrono::steady_clock::now();
+		bool valid_certified { ss->isValid(ss->getNewState(q1->getCoord()), ss->getNewState(q2->getCoord())) };
+		times_certified.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - time_start).count() * 1e-3);
+
+		num_rejected += !valid;
+		num_different += (valid != valid_certified);
+	}
+	RealVectorSpaceConfig::CERTIFIED_EDGE_VALIDATION = certified_edge_validation;
+
+	LOG(INFO) << "Edge length: " << edge_length << "\t Num. rejected edges: " << num_rejected << " of " << num_edges;
+	LOG(INFO) << "\t Time of isValid(q1, q2) using discrete checks:  " << getMean(times_discrete) << " +- " << getStd(times_discrete) << " [us]";
+	LOG(INFO) << "\t Time of isValid(q1, q2) using certified checks: " << getMean(times_certified) << " +- " << getStd(times_certified) << " [us]";
+	if (num_different > 0)
+		LOG(ERROR) << "\t Num. edges with different result: " << num_different;
+}
+
+// Check 'num_edges' random edges of length 'edge_length' starting from self-collision-free configurations,
+// and measure the time of 'checkSelfCollision(q1, q2)' per edge, compared to checking 'NUM_INTERPOLATION_VALIDITY_CHECKS' 
+// configurations along the edge using 'checkSelfCollision(q)'. Interpolated checks may miss self-collisions between them,
+// while 'checkSelfCollision(q1, q2)' checks the whole edge with the resolution 'RRTConnectConfig::EPS_STEP'.
+void benchmarkSelfCollision(const std::shared_ptr<base::StateSpace> ss, size_t num_edges, float edge_length)
+{
+	const size_t num_checks { RealVectorSpaceConfig::NUM_INTERPOLATION_VALIDITY_CHECKS };
+	std::vector<float> times {}, times_interpolated {};
+	size_t num_colliding { 0 }, num_colliding_interpolated { 0 };
+
+	for (size_t i = 0; i < num_edges; )
+	{
+		std::shared_ptr<base::State> q1 { ss->getRandomState() };
+		if (ss->robot->checkSelfCollision(q1))
+			continue;
+
+		std::shared_ptr<base::State> q2 { ss->interpolateEdge(q1, ss->getRandomState(), edge_length) };
+		i++;
+
+		std::shared_ptr<base::State> q2_temp { ss->getNewState(q2->getCoord()) };
+		std::chrono::steady_clock::time_point time_start { std::chrono::steady_clock::now() };
+		num_colliding += ss->robot->checkSelfCollision(ss->getNewState(q1->getCoord()), q2_temp);
+		times.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - time_start).count() * 1e-3);
+
+		time_start = std::chrono::steady_clock::now();
+		for (size_t k = 1; k <= num_checks; k++)
+		{
+			if (ss->robot->checkSelfCollision(ss->getNewState(q1->getCoord() + (q2->getCoord() - q1->getCoord()) * (float(k) / num_checks))))
+			{
+				num_colliding_interpolated++;
+				break;
+			}
+		}
+		times_interpolated.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - time_start).count() * 1e-3);
+	}
+
+	LOG(INFO) << "Edge length: " << edge_length << "\t Num. self-colliding edges: " << num_colliding << " of " << num_edges 
+			  << " (" << num_colliding_interpolated << " using interpolated checks)";
+	LOG(INFO) << "\t Time of checkSelfCollision(q1, q2) per edge:         " << getMean(times) << " +- " << getStd(times) << " [us]";
+	LOG(INFO) << "\t Time of interpolated checkSelfCollision(q) per edge: " << getMean(times_interpolated) << " +- " << getStd(times_interpolated) << " [us]";
+}
+
+int main(int argc, char **argv)
+{
+	std::vector<std::string> scenario_file_paths
+	{
+		"/data/xarm6/scenario_test/scenario_test.yaml",
+		"/data/xarm6/scenario1/scenario1.yaml",
+		"/data/xarm6/scenario2/scenario2.yaml",
+		"/data/xarm6/scenario3/scenario3.yaml"
+	};
+	std::vector<std::string> self_collision_scenario_file_paths
+	{
+		"/data/planar_10dof/scenario_test/scenario_test.yaml",
+		"/data/planar_10dof/scenario1/scenario1.yaml",
+		"/data/planar_10dof/scenario2/scenario2.yaml"
+	};
+	size_t num_edges { 10000 };
+
+	initGoogleLogging(argv);
+	int clp = commandLineParser(argc, argv, scenario_file_paths.front());
+	if (clp != 0) return clp;
+
+	const std::string project_path { getProjectPath() };
+	ConfigurationReader::initConfiguration(project_path);
+	LOG(INFO) << "Num. interpolation validity checks: " << RealVectorSpaceConfig::NUM_INTERPOLATION_VALIDITY_CHECKS;
+	LOG(INFO) << "Edge length: " << RRTConnectConfig::EPS_STEP;
+
+	for (const std::string &scenario_file_path : scenario_file_paths)
+	{
+		scenario::Scenario scenario(scenario_file_path, project_path);
+		std::shared_ptr<base::StateSpace> ss { scenario.getStateSpace() };
+
+		LOG(INFO) << "----------------------------------------------------------------------------------------";
+		LOG(INFO) << "Using scenario: " << project_path + scenario_file_path;
+		LOG(INFO) << "State space type: " << ss->getStateSpaceType();
+		LOG(INFO) << "Number of objects in environment: " << scenario.getEnvironment()->getNumObjects();
+		benchmarkEdgeCheckOrder(ss, num_edges);
+
+		LOG(INFO) << "Certified edge validation: ";
+		for (float edge_length : { RRTConnectConfig::EPS_STEP, 2 * RRTConnectConfig::EPS_STEP, 4 * RRTConnectConfig::EPS_STEP })
+			benchmarkCertifiedEdgeValidation(ss, num_edges, edge_length);
+	}
+
+	for (const std::string &scenario_file_path : self_collision_scenario_file_paths)
+	{
+		scenario::Scenario scenario(scenario_file_path, project_path);
+		std::shared_ptr<base::StateSpace> ss { scenario.getStateSpace() };
+
+		LOG(INFO) << "----------------------------------------------------------------------------------------";
+		LOG(INFO) << "Using scenario: " << project_path + scenario_file_path;
+		LOG(INFO) << "Self-collision checking: ";
+		for (float edge_length : { RRTConnectConfig::EPS_STEP, 4 * RRTConnectConfig::EPS_STEP, 16 * RRTConnectConfig::EPS_STEP })
+			benchmarkSelfCollision(ss, num_edges, edge_length);
+	}
+
+	google::ShutDownCommandLineFlags();
+	return 0;
+}
\ No newline at end of file
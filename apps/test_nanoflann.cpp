@@ -1,33 +1,359 @@
 //
 // Created by dinko on 24.5.21.
-// Taken from nanoflann examples
 //
 
+#include "RRTConnect.h"
+#include "RGBTConnect.h"
+#include "ConfigurationReader.h"
+#include "CommonFunctions.h"
+#include <atomic>
 
-#include <ctime>
-#include <cstdlib>
-#include <ostream>
+// Number of memory allocations made through 'operator new', which is replaced in order to count them.
+// Note that Eigen allocates coordinate buffers using 'malloc', so they are not counted.
+std::atomic<size_t> num_allocations { 0 };
 
-#include <nanoflann.hpp>
+void *operator new(size_t size)
+{
+	num_allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void *ptr = std::malloc(size))
+		return ptr;
+	
+	throw std::bad_alloc();
+}
 
-#include "RealVectorSpaceState.h"
-#include "RealVectorSpace.h"
-#include "State.h"
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
 
-// TODO: NOT working with smart pointer changes
+// Return the elapsed time since 'time_start' in [us]
+float getElapsedTime(const std::chrono::steady_clock::time_point &time_start)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - time_start).count() * 1e-3;
+}
 
-void generateRandomStates([[maybe_unused]] base::StateSpace* ss, [[maybe_unused]] std::vector<base::State*>& states, [[maybe_unused]] int N = 20)
+// Grow a tree from 'coords' (each state is connected to its nearest state), and measure insertion time,
+// nearest-neighbour query times (using exact and approximate Kd-tree search, batched k-NN and linear scan) for 'queries', 
+// and path extraction times.
+// The storage layout of the tree is determined by 'TreeConfig::CONTIGUOUS_STORAGE', and the metric by 'ss'.
+void benchmarkTree(const std::shared_ptr<base::StateSpace> ss, const std::vector<Eigen::VectorXf> &coords,
+				   const std::vector<Eigen::VectorXf> &queries)
 {
-	return;
+	std::shared_ptr<base::Tree> tree { std::make_shared<base::Tree>("benchmark", 0) };
+	tree->setMetricWeights(ss->getMetricWeights());
+
+	std::chrono::steady_clock::time_point time_start { std::chrono::steady_clock::now() };
+	tree->upgradeTree(ss->getNewState(coords.front()), nullptr);
+	for (size_t i = 1; i < coords.size(); i++)
+	{
+		std::shared_ptr<base::State> q { ss->getNewState(coords[i]) };
+		tree->upgradeTree(q, tree->getNearestState(q));
+	}
+	float time_build { getElapsedTime(time_start) };
+
+	std::vector<std::shared_ptr<base::State>> q_queries {};
+	for (const Eigen::VectorXf &coord : queries)
+		q_queries.emplace_back(ss->getNewState(coord));
+
+	std::vector<size_t> nearest_idx {};
+	time_start = std::chrono::steady_clock::now();
+	for (std::shared_ptr<base::State> q : q_queries)
+		nearest_idx.emplace_back(tree->getNearestState(q)->getIdx());
+	float time_kd_tree { getElapsedTime(time_start) };
+
+	const float approx_eps { 1 };
+	size_t num_approx_mismatches { 0 };
+	tree->setApproxEps(approx_eps);
+	time_start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < q_queries.size(); i++)
+	{
+		if (tree->getNearestState(q_queries[i])->getIdx() != nearest_idx[i])
+			num_approx_mismatches++;
+	}
+	float time_kd_tree_approx { getElapsedTime(time_start) };
+	tree->setApproxEps(0);
+
+	time_start = std::chrono::steady_clock::now();
+	tree->getKNearestStates(q_queries, 10);
+	float time_knn { getElapsedTime(time_start) };
+
+	time_start = std::chrono::steady_clock::now();
+	tree->getKNearestStates(q_queries, 10, true);
+	float time_knn_parallel { getElapsedTime(time_start) };
+
+	size_t num_mismatches { 0 };
+	time_start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < q_queries.size(); i++)
+	{
+		if (tree->getNearestState2(q_queries[i])->getIdx() != nearest_idx[i])
+			num_mismatches++;
+	}
+	float time_linear_scan { getElapsedTime(time_start) };
+
+	size_t path_length { 0 };
+	time_start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < q_queries.size(); i++)
+		path_length += tree->computePathToRoot(nearest_idx[i]).size();
+	float time_path { getElapsedTime(time_start) };
+
+	LOG(INFO) << "Storage: " << (tree->getContiguousStorage() ? "contiguous arrays" : "states")
+			  << "\t Metric: " << (ss->getMetricWeights().size() == 0 ? "Euclidean" : "weighted")
+			  << "\t Num. states: " << tree->getNumStates();
+	LOG(INFO) << "\t Building time:                  " << time_build / coords.size() << " [us/state]";
+	LOG(INFO) << "\t Nearest state (Kd-tree):        " << time_kd_tree / queries.size() << " [us/query]";
+	LOG(INFO) << "\t Nearest state (eps = " << approx_eps << "):        " << time_kd_tree_approx / queries.size() << " [us/query]"
+			  << " (" << num_approx_mismatches << " non-nearest)";
+	LOG(INFO) << "\t 10 nearest states (batched):    " << time_knn / queries.size() << " [us/query]";
+	LOG(INFO) << "\t 10 nearest states (parallel):   " << time_knn_parallel / queries.size() << " [us/query]";
+	LOG(INFO) << "\t Nearest state (linear scan):    " << time_linear_scan / queries.size() << " [us/query]"
+			  << " (" << num_mismatches << " mismatches)";
+	LOG(INFO) << "\t Path to root extraction:        " << time_path / queries.size() << " [us/path]"
+			  << " (avg. length " << (float) path_length / queries.size() << ")";
 }
 
-void buildKDTree([[maybe_unused]] std::vector<base::State*>& states)
+// Return the 'p'-th percentile of 'v'
+float getPercentile(std::vector<float> v, float p)
 {
-	return; 
+	std::sort(v.begin(), v.end());
+	return v[std::min<size_t>(p / 100 * v.size(), v.size() - 1)];
 }
 
-int main()
+// Grow a tree from 'coords' as in 'benchmarkTree', and report the distribution of latencies of 'getNearestState' and 'upgradeTree'.
+// The Kd-tree type is determined by 'TreeConfig::STATIC_KD_TREE_THRESHOLD'.
+void benchmarkTailLatency(const std::shared_ptr<base::StateSpace> ss, const std::vector<Eigen::VectorXf> &coords)
 {
-	return 0;
+	std::shared_ptr<base::Tree> tree { std::make_shared<base::Tree>("benchmark", 0) };
+	tree->setMetricWeights(ss->getMetricWeights());
+	tree->upgradeTree(ss->getNewState(coords.front()), nullptr);
+
+	std::vector<float> times_query {}, times_upgrade {};
+	std::chrono::steady_clock::time_point time_start {};
+	for (size_t i = 1; i < coords.size(); i++)
+	{
+		std::shared_ptr<base::State> q { ss->getNewState(coords[i]) };
+		time_start = std::chrono::steady_clock::now();
+		std::shared_ptr<base::State> q_near { tree->getNearestState(q) };
+		times_query.emplace_back(getElapsedTime(time_start));
+
+		time_start = std::chrono::steady_clock::now();
+		tree->upgradeTree(q, q_near);
+		times_upgrade.emplace_back(getElapsedTime(time_start));
+	}
+
+	LOG(INFO) << "Kd-tree: " << (TreeConfig::STATIC_KD_TREE_THRESHOLD > 0 ? "static + buffer" : "dynamic")
+			  << "\t Num. states: " << tree->getNumStates();
+	for (auto [name, times] : {std::pair("getNearestState", times_query), std::pair("upgradeTree", times_upgrade)})
+		LOG(INFO) << "\t " << name << " [us]: mean " << getMean(times) << "\t p50 " << getPercentile(times, 50) 
+				  << "\t p99 " << getPercentile(times, 99) << "\t p99.9 " << getPercentile(times, 99.9) 
+				  << "\t max " << getPercentile(times, 100);
 }
 
+// Grow 'num_trees' small trees of 'num_states' nodes, as RGBMT* does with local trees, where each insertion is preceded 
+// by a nearest-neighbour query, and report the average time per tree. 
+// The search method is determined by 'TreeConfig::LINEAR_SEARCH_THRESHOLD'.
+void benchmarkSmallTrees(const std::shared_ptr<base::StateSpace> ss, size_t num_states, size_t num_trees)
+{
+	std::vector<std::shared_ptr<base::State>> q_states {};
+	for (size_t i = 0; i < num_states; i++)
+		q_states.emplace_back(ss->getRandomState());
+
+	std::chrono::steady_clock::time_point time_start { std::chrono::steady_clock::now() };
+	for (size_t num_tree = 0; num_tree < num_trees; num_tree++)
+	{
+		std::shared_ptr<base::Tree> tree { std::make_shared<base::Tree>("local", 0) };
+		tree->setMetricWeights(ss->getMetricWeights());
+		tree->upgradeTree(ss->getNewState(q_states.front()->getCoord()), nullptr);
+		for (size_t i = 1; i < num_states; i++)
+		{
+			std::shared_ptr<base::State> q { ss->getNewState(q_states[i]->getCoord()) };
+			tree->upgradeTree(q, tree->getNearestState(q));
+		}
+	}
+	float time_trees { getElapsedTime(time_start) };
+
+	LOG(INFO) << "Search: " << (num_states > TreeConfig::LINEAR_SEARCH_THRESHOLD ? "Kd-tree" : "linear (SIMD)")
+			  << "\t Num. states: " << num_states << "\t Time: " << time_trees / num_trees << " [us/tree]";
+}
+
+// Solve the scenario 'max_num_tests' times with 'planner_name' (RRTConnect or RGBTConnect), 
+// and report success rate, planning time, number of collision queries, number of allocations per iteration
+// and hit rate of the kinematics cache
+void benchmarkPlanner(const std::string &planner_name, const std::shared_ptr<base::StateSpace> ss, 
+					  const std::shared_ptr<base::State> q_start, const std::shared_ptr<base::State> q_goal, size_t max_num_tests)
+{
+	size_t num_success { 0 };
+	std::vector<float> planning_times {}, num_collision_queries {}, num_allocations_per_iter {}, cache_hit_rates {};
+	for (size_t num_test = 0; num_test < max_num_tests; num_test++)
+	{
+		std::unique_ptr<planning::AbstractPlanner> planner { nullptr };
+		if (planner_name == "RGBTConnect")
+			planner = std::make_unique<planning::rbt::RGBTConnect>(ss, q_start, q_goal);
+		else
+			planner = std::make_unique<planning::rrt::RRTConnect>(ss, q_start, q_goal);
+		
+		size_t num_allocations_init { num_allocations };
+		bool result { planner->solve() };
+		num_allocations_per_iter.emplace_back(float(num_allocations - num_allocations_init) / 
+											  std::max<size_t>(planner->getPlannerInfo()->getNumIterations(), 1));
+		cache_hit_rates.emplace_back(planner->getPlannerInfo()->getKinematicsCacheHitRate() * 100);
+		if (result)
+		{
+			num_success++;
+			planning_times.emplace_back(planner->getPlannerInfo()->getPlanningTime());
+			num_collision_queries.emplace_back(planner->getPlannerInfo()->getNumCollisionQueries());
+		}
+	}
+	LOG(INFO) << "Planner: " << planner_name
+			  << "\t Storage: " << (TreeConfig::CONTIGUOUS_STORAGE ? "contiguous arrays" : "states")
+			  << "\t Metric: " << (ss->getMetricWeights().size() == 0 ? "Euclidean" : "weighted")
+			  << "\t NN eps: " << (planner_name == "RGBTConnect" ? RGBTConnectConfig::NN_APPROX_EPS : RRTConnectConfig::NN_APPROX_EPS)
+			  << "\t State pool: " << (RealVectorSpaceConfig::STATE_POOL_CHUNK_SIZE > 0 ? "on" : "off")
+			  << "\t Kinematics cache: " << RealVectorSpaceConfig::KINEMATICS_CACHE_SIZE << " [MB]";
+	LOG(INFO) << "\t Success rate:           " << (float) num_success / max_num_tests * 100 << " [%]";
+	LOG(INFO) << "\t Average planning time:  " << getMean(planning_times) << " +- " << getStd(planning_times) << " [s]";
+	LOG(INFO) << "\t Num. collision queries: " << getMean(num_collision_queries) << " +- " << getStd(num_collision_queries);
+	LOG(INFO) << "\t Allocations per iter.:  " << getMean(num_allocations_per_iter) << " +- " << getStd(num_allocations_per_iter);
+	if (RealVectorSpaceConfig::KINEMATICS_CACHE_SIZE > 0)
+		LOG(INFO) << "\t Kinematics cache hits:  " << getMean(cache_hit_rates) << " +- " << getStd(cache_hit_rates) << " [%]";
+}
+
+int main(int argc, char **argv)
+{
+	std::string scenario_file_path
+	{
+		// "/data/planar_2dof/scenario_test/scenario_test.yaml"
+		// "/data/planar_10dof/scenario_test/scenario_test.yaml"
+		"/data/xarm6/scenario_test/scenario_test.yaml"
+	};
+	const std::vector<size_t> num_states { 1000, 10000, 100000 };	// Tree sizes to be benchmarked
+	const size_t num_queries { 1000 };								// Number of nearest-neighbour queries per tree
+
+	initGoogleLogging(argv);
+	int clp = commandLineParser(argc, argv, scenario_file_path);
+	if (clp != 0) return clp;
+
+	const std::string project_path { getProjectPath() };
+	ConfigurationReader::initConfiguration(project_path);
+    YAML::Node node { YAML::LoadFile(project_path + scenario_file_path) };
+	const size_t max_num_tests { node["testing"]["max_num"].as<size_t>() };
+
+	scenario::Scenario scenario(scenario_file_path, project_path);
+	std::shared_ptr<base::StateSpace> ss { scenario.getStateSpace() };
+
+	LOG(INFO) << "Using scenario: " << project_path + scenario_file_path;
+	LOG(INFO) << "Number of DOFs: " << ss->num_dimensions;
+
+	// The Euclidean metric is used, unless stated otherwise
+	const Eigen::VectorXf metric_weights { std::static_pointer_cast<base::RealVectorSpace>(ss)->computeMetricWeights() };
+	ss->setMetricWeights(Eigen::VectorXf());
+	LOG(INFO) << "Weights of the weighted metric: " << metric_weights.transpose();
+
+	// The dynamic Kd-tree is used, unless stated otherwise
+	const size_t static_kd_tree_threshold { TreeConfig::STATIC_KD_TREE_THRESHOLD };
+	const size_t linear_search_threshold { TreeConfig::LINEAR_SEARCH_THRESHOLD };
+	TreeConfig::STATIC_KD_TREE_THRESHOLD = 0;
+	TreeConfig::LINEAR_SEARCH_THRESHOLD = 0;
+
+	// Small (local) trees using linear search vs. Kd-tree
+	for (size_t N : {5, 10, 20, 50, 100})
+	{
+		for (size_t threshold : {size_t(0), linear_search_threshold})
+		{
+			TreeConfig::LINEAR_SEARCH_THRESHOLD = threshold;
+			benchmarkSmallTrees(ss, N, 1000);
+		}
+	}
+	TreeConfig::LINEAR_SEARCH_THRESHOLD = 0;
+	LOG(INFO) << "\n--------------------------------------------------------------------\n\n";
+
+	for (size_t N : num_states)
+	{
+		std::vector<Eigen::VectorXf> coords {};
+		std::vector<Eigen::VectorXf> queries {};
+		for (size_t i = 0; i < N; i++)
+			coords.emplace_back(ss->getRandomState()->getCoord());
+		for (size_t i = 0; i < num_queries; i++)
+			queries.emplace_back(ss->getRandomState()->getCoord());
+
+		// The same states and queries are used for both layouts
+		for (bool contiguous_storage : {false, true})
+		{
+			TreeConfig::CONTIGUOUS_STORAGE = contiguous_storage;
+			benchmarkTree(ss, coords, queries);
+		}
+
+		// Nearest-neighbour queries using the weighted metric
+		ss->setMetricWeights(metric_weights);
+		benchmarkTree(ss, coords, queries);
+		ss->setMetricWeights(Eigen::VectorXf());
+		LOG(INFO) << "\n--------------------------------------------------------------------\n\n";
+	}
+
+	// Tail latency of the dynamic Kd-tree vs. the static Kd-tree with the buffer of recently added states
+	std::vector<Eigen::VectorXf> coords {};
+	for (size_t i = 0; i < num_states.back(); i++)
+		coords.emplace_back(ss->getRandomState()->getCoord());
+	
+	for (size_t threshold : {size_t(0), static_kd_tree_threshold})
+	{
+		TreeConfig::STATIC_KD_TREE_THRESHOLD = threshold;
+		benchmarkTailLatency(ss, coords);
+	}
+	TreeConfig::STATIC_KD_TREE_THRESHOLD = 0;
+	LOG(INFO) << "\n--------------------------------------------------------------------\n\n";
+
+	TreeConfig::LINEAR_SEARCH_THRESHOLD = linear_search_threshold;
+	for (bool contiguous_storage : {false, true})
+	{
+		TreeConfig::CONTIGUOUS_STORAGE = contiguous_storage;
+		benchmarkPlanner("RRTConnect", ss, scenario.getStart(), scenario.getGoal(), max_num_tests);
+	}
+
+	// RRT-Connect using the weighted metric
+	ss->setMetricWeights(metric_weights);
+	benchmarkPlanner("RRTConnect", ss, scenario.getStart(), scenario.getGoal(), max_num_tests);
+	ss->setMetricWeights(Eigen::VectorXf());
+	LOG(INFO) << "\n--------------------------------------------------------------------\n\n";
+
+	// Exact vs. approximate nearest-neighbour search
+	const float rrt_connect_eps { RRTConnectConfig::NN_APPROX_EPS };
+	const float rgbt_connect_eps { RGBTConnectConfig::NN_APPROX_EPS };
+	for (const std::string planner_name : {"RRTConnect", "RGBTConnect"})
+	{
+		for (float eps : {0.0, 0.5, 1.0, 2.0})
+		{
+			RRTConnectConfig::NN_APPROX_EPS = eps;
+			RGBTConnectConfig::NN_APPROX_EPS = eps;
+			benchmarkPlanner(planner_name, ss, scenario.getStart(), scenario.getGoal(), max_num_tests);
+		}
+	}
+	RRTConnectConfig::NN_APPROX_EPS = rrt_connect_eps;
+	RGBTConnectConfig::NN_APPROX_EPS = rgbt_connect_eps;
+	LOG(INFO) << "\n--------------------------------------------------------------------\n\n";
+
+	// States allocated from the heap vs. from the memory pool of each planner
+	const size_t state_pool_chunk_size { RealVectorSpaceConfig::STATE_POOL_CHUNK_SIZE };
+	for (const std::string planner_name : {"RRTConnect", "RGBTConnect"})
+	{
+		for (size_t chunk_size : {size_t(0), state_pool_chunk_size})
+		{
+			RealVectorSpaceConfig::STATE_POOL_CHUNK_SIZE = chunk_size;
+			benchmarkPlanner(planner_name, ss, scenario.getStart(), scenario.getGoal(), max_num_tests);
+		}
+	}
+	RealVectorSpaceConfig::STATE_POOL_CHUNK_SIZE = state_pool_chunk_size;
+	LOG(INFO) << "\n--------------------------------------------------------------------\n\n";
+
+	// Kinematic quantities kept in all states vs. bounded by the kinematics cache of each planner
+	const size_t kinematics_cache_size { RealVectorSpaceConfig::KINEMATICS_CACHE_SIZE };
+	for (const std::string planner_name : {"RRTConnect", "RGBTConnect"})
+	{
+		for (size_t cache_size : {size_t(0), size_t(1), size_t(16)})
+		{
+			RealVectorSpaceConfig::KINEMATICS_CACHE_SIZE = cache_size;
+			benchmarkPlanner(planner_name, ss, scenario.getStart(), scenario.getGoal(), max_num_tests);
+		}
+	}
+	RealVectorSpaceConfig::KINEMATICS_CACHE_SIZE = kinematics_cache_size;
+
+	google::ShutDownCommandLineFlags();
+	return 0;
+}
@@ -2,6 +2,99 @@
 #include "RealVectorSpace.h"
 #include "RealVectorSpaceFCL.h"
 #include "CommonFunctions.h"
+#include <chrono>
+
+// Measure the time per capsule-box pair of 'distanceCapsuleToBox' returning nearest points via 'std::shared_ptr', 
+// and of its variant without heap allocations, for 'num_pairs' random pairs. Both must give the same result.
+void benchmarkCapsuleToBoxDistance(size_t num_pairs)
+{
+	std::vector<Eigen::Vector3f> A(num_pairs), B(num_pairs);
+	std::vector<Eigen::VectorXf> obs(num_pairs, Eigen::VectorXf(6));
+	const float radius { 0.05 };
+	for (size_t i = 0; i < num_pairs; i++)
+	{
+		A[i] = Eigen::Vector3f::Random();
+		B[i] = A[i] + 0.4 * Eigen::Vector3f::Random();
+		Eigen::Vector3f center { Eigen::Vector3f::Random() };
+		Eigen::Vector3f half_size { 0.05 * Eigen::Vector3f::Ones() + 0.2 * Eigen::Vector3f::Random().cwiseAbs() };
+		obs[i] << center - half_size, center + half_size;
+	}
+
+	std::vector<float> d_c(num_pairs), d_c_fixed(num_pairs);
+	std::shared_ptr<Eigen::MatrixXf> nearest_pts { nullptr };
+	base::NearestPoints nearest_pts_fixed {};
+
+	std::chrono::steady_clock::time_point time_start { std::chrono::steady_clock::now() };
+	for (size_t i = 0; i < num_pairs; i++)
+		tie(d_c[i], nearest_pts) = base::CollisionAndDistance::distanceCapsuleToBox(A[i], B[i], radius, obs[i]);
+	float time { std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - time_start).count() / float(num_pairs) };
+
+	time_start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < num_pairs; i++)
+		d_c_fixed[i] = base::CollisionAndDistance::distanceCapsuleToBox(A[i], B[i], radius, obs[i], nearest_pts_fixed);
+	float time_fixed { std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - time_start).count() / float(num_pairs) };
+
+	size_t num_different { 0 };
+	for (size_t i = 0; i < num_pairs; i++)
+		num_different += (std::abs(d_c[i] - d_c_fixed[i]) > RealVectorSpaceConfig::EQUALITY_THRESHOLD);
+
+	LOG(INFO) << "Time of distanceCapsuleToBox per pair (" << num_pairs << " pairs): ";
+	LOG(INFO) << "\t Using std::shared_ptr output:    " << time << " [ns]";
+	LOG(INFO) << "\t Using fixed-size output:         " << time_fixed << " [ns]";
+	if (num_different > 0)
+		LOG(ERROR) << "\t Num. pairs with different result: " << num_different;
+}
+
+// Measure the time of 'isValid(q)' and 'computeDistance(q)' for 'num_configs' random configurations in the scenario 
+// 'scenario_file_path' containing sphere obstacles, and in the same scenario where each sphere is replaced by its bounding box.
+void benchmarkSpheresAndBoxes(const std::string &scenario_file_path, const std::string &project_path, size_t num_configs)
+{
+	scenario::Scenario scenario_spheres(scenario_file_path, project_path);
+	scenario::Scenario scenario_boxes(scenario_file_path, project_path);
+	std::shared_ptr<env::Environment> env_boxes { scenario_boxes.getEnvironment() };
+	const std::vector<std::shared_ptr<env::Object>> objects { env_boxes->getObjects() };
+	size_t num_spheres { 0 };
+
+	env_boxes->removeAllObjects();
+	for (const std::shared_ptr<env::Object> &object : objects)
+	{
+		std::shared_ptr<env::Sphere> sphere { std::dynamic_pointer_cast<env::Sphere>(object) };
+		if (sphere == nullptr)
+		{
+			env_boxes->addObject(object);
+			continue;
+		}
+
+		std::shared_ptr<env::Object> box { std::make_shared<env::Box>(2 * sphere->getRadius() * fcl::Vector3f::Ones(), 
+			sphere->getPosition(), fcl::Quaternionf::Identity(), sphere->getLabel()) };
+		box->setMinDistTol(sphere->getMinDistTol());
+		env_boxes->addObject(box);
+		num_spheres++;
+	}
+
+	std::vector<std::shared_ptr<base::StateSpace>> spaces { scenario_spheres.getStateSpace(), scenario_boxes.getStateSpace() };
+	std::vector<std::shared_ptr<base::State>> configs(num_configs);
+	for (size_t i = 0; i < num_configs; i++)
+		configs[i] = spaces.front()->getRandomState();
+
+	LOG(INFO) << "Time per configuration (" << num_configs << " configurations, " << num_spheres << " spheres): ";
+	for (size_t k = 0; k < spaces.size(); k++)
+	{
+		size_t num_valid { 0 };
+		std::chrono::steady_clock::time_point time_start { std::chrono::steady_clock::now() };
+		for (size_t i = 0; i < num_configs; i++)
+			num_valid += spaces[k]->isValid(configs[i]);
+		float time_valid { std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - time_start).count() * 1e-3f / num_configs };
+
+		time_start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < num_configs; i++)
+			spaces[k]->computeDistance(configs[i], true);
+		float time_distance { std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - time_start).count() * 1e-3f / num_configs };
+
+		LOG(INFO) << (k == 0 ? "\t Using spheres:        " : "\t Using bounding boxes: ") << "isValid(q): " << time_valid 
+				  << " [us]\t computeDistance(q): " << time_distance << " [us]\t Num. valid: " << num_valid;
+	}
+}
 
 int main(int argc, char **argv)
 {
@@ -87,6 +180,9 @@ int main(int argc, char **argv)
 		LOG(ERROR) << e.what();
 	}
 
+	benchmarkCapsuleToBoxDistance(1000000);
+	benchmarkSpheresAndBoxes("/data/xarm6/scenario_spheres/scenario_spheres.yaml", project_path, 10000);
+
 	google::ShutDownCommandLineFlags();
 	return 0;
 }
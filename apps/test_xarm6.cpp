@@ -4,7 +4,128 @@
 #include "ConfigurationReader.h"
 #include "CommonFunctions.h"
 #include "xArm6.h"
+#include "CapsuleRobot.h"
 #include "RealVectorSpaceFCL.h"
+#include <chrono>
+
+// Compare the closed-form FK solver with KDL tree solver for 'num_configs' random configurations, 
+// and measure the time of both per configuration.
+void benchmarkForwardKinematics(const std::shared_ptr<robots::xArm6> robot, size_t num_configs)
+{
+	std::vector<Eigen::VectorXf> configs(num_configs);
+	for (size_t k = 0; k < num_configs; k++)
+		configs[k] = M_PI * Eigen::VectorXf::Random(robot->getNumDOFs());
+
+	std::vector<KDL::Frame> frames(robot->getNumDOFs()), frames_kdl(robot->getNumDOFs());
+	float time { 0 }, time_kdl { 0 }, max_error { 0 };
+	for (size_t k = 0; k < num_configs; k++)
+	{
+		std::chrono::steady_clock::time_point time_start { std::chrono::steady_clock::now() };
+		robot->computeForwardKinematics(configs[k], frames);
+		time += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - time_start).count() * 1e-3;
+
+		time_start = std::chrono::steady_clock::now();
+		robot->computeForwardKinematicsKDL(configs[k], frames_kdl);
+		time_kdl += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - time_start).count() * 1e-3;
+
+		for (size_t i = 0; i < frames.size(); i++)
+			max_error = std::max(max_error, float((frames[i].p - frames_kdl[i].p).Norm()));
+	}
+
+	LOG(INFO) << "Time of FK per configuration (" << num_configs << " configurations): ";
+	LOG(INFO) << "\t Using closed-form solver: " << time / num_configs << " [us]";
+	LOG(INFO) << "\t Using KDL tree solver:    " << time_kdl / num_configs << " [us]";
+	LOG(INFO) << "\t Max. position error:      " << max_error << " [m]";
+}
+
+// Compute skeletons of 'num_configs' random configurations in batches of 'batch_size' configurations, 
+// and compare the time and the result with computing each skeleton separately.
+void benchmarkBatchSkeletons(const std::shared_ptr<robots::xArm6> robot, size_t num_configs, size_t batch_size)
+{
+	robots::BatchSoA q_coords(robot->getNumDOFs(), batch_size), skeletons {};
+	Eigen::MatrixXf skeleton(3, robot->getNumDOFs() + 1);
+	Eigen::VectorXf q_coord(robot->getNumDOFs());
+	float time { 0 }, time_batch { 0 }, max_error { 0 };
+	for (size_t k = 0; k < num_configs; k += batch_size)
+	{
+		q_coords = M_PI * robots::BatchSoA::Random(robot->getNumDOFs(), batch_size);
+		std::chrono::steady_clock::time_point time_start { std::chrono::steady_clock::now() };
+		robot->computeSkeletons(q_coords, skeletons);
+		time_batch += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - time_start).count() * 1e-3;
+
+		for (size_t n = 0; n < batch_size; n++)
+		{
+			q_coord = q_coords.col(n).matrix();
+			time_start = std::chrono::steady_clock::now();
+			robot->computeSkeleton(q_coord, skeleton);
+			time += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - time_start).count() * 1e-3;
+			max_error = std::max(max_error, (skeletons.col(n).matrix() - skeleton.reshaped()).cwiseAbs().maxCoeff());
+		}
+	}
+
+	LOG(INFO) << "Time of skeleton computation per configuration (batch size " << batch_size << "): ";
+	LOG(INFO) << "\t Each configuration separately: " << time / num_configs << " [us]";
+	LOG(INFO) << "\t Batch of configurations:       " << time_batch / num_configs << " [us]";
+	LOG(INFO) << "\t Max. position error:           " << max_error << " [m]";
+}
+
+// Compare the generic capsule robot (read from 'xarm6_capsules.yaml') with the hand-coded xArm6 robot for 'num_configs' 
+// random configurations, and measure the time of skeleton, enclosing radii and self-collision computation using both.
+void benchmarkCapsuleRobot(const std::shared_ptr<robots::xArm6> robot, const std::shared_ptr<robots::CapsuleRobot> capsule_robot, 
+						   size_t num_configs)
+{
+	std::vector<std::shared_ptr<base::State>> states(num_configs), states_capsule(num_configs);
+	for (size_t k = 0; k < num_configs; k++)
+	{
+		Eigen::VectorXf rand { Eigen::VectorXf::Random(robot->getNumDOFs()) };
+		for (size_t i = 0; i < robot->getNumDOFs(); i++)
+			rand(i) = ((robot->getLimits()[i].second - robot->getLimits()[i].first) * rand(i) 
+					  + robot->getLimits()[i].first + robot->getLimits()[i].second) / 2;
+		states[k] = std::make_shared<base::RealVectorSpaceState>(rand);
+		states_capsule[k] = std::make_shared<base::RealVectorSpaceState>(rand);
+	}
+
+	auto measure = [&](const std::shared_ptr<robots::AbstractRobot> r, const std::vector<std::shared_ptr<base::State>> &s, 
+					   std::vector<bool> &self_collision, std::vector<float> &times)
+	{
+		times = std::vector<float>(3, 0);
+		std::chrono::steady_clock::time_point time_start { std::chrono::steady_clock::now() };
+		for (size_t k = 0; k < num_configs; k++)
+			r->computeSkeleton(s[k]);
+		times[0] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - time_start).count() * 1e-3;
+
+		time_start = std::chrono::steady_clock::now();
+		for (size_t k = 0; k < num_configs; k++)
+			r->computeEnclosingRadii(s[k]);
+		times[1] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - time_start).count() * 1e-3;
+
+		self_collision = std::vector<bool>(num_configs);
+		time_start = std::chrono::steady_clock::now();
+		for (size_t k = 0; k < num_configs; k++)
+			self_collision[k] = r->checkSelfCollision(s[k]);
+		times[2] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - time_start).count() * 1e-3;
+	};
+
+	std::vector<bool> self_collision {}, self_collision_capsule {};
+	std::vector<float> times {}, times_capsule {};
+	measure(robot, states, self_collision, times);
+	measure(capsule_robot, states_capsule, self_collision_capsule, times_capsule);
+
+	float max_error { 0 };
+	size_t num_different { 0 };
+	for (size_t k = 0; k < num_configs; k++)
+	{
+		max_error = std::max(max_error, (*states[k]->getSkeleton() - *states_capsule[k]->getSkeleton()).cwiseAbs().maxCoeff());
+		num_different += (self_collision[k] != self_collision_capsule[k]);
+	}
+
+	LOG(INFO) << "Time per configuration using xArm6 / capsule robot (" << num_configs << " configurations): ";
+	LOG(INFO) << "\t Skeleton:        " << times[0] / num_configs << " / " << times_capsule[0] / num_configs << " [us]";
+	LOG(INFO) << "\t Enclosing radii: " << times[1] / num_configs << " / " << times_capsule[1] / num_configs << " [us]";
+	LOG(INFO) << "\t Self-collision:  " << times[2] / num_configs << " / " << times_capsule[2] / num_configs << " [us]";
+	LOG(INFO) << "\t Max. skeleton position error: " << max_error << " [m]";
+	LOG(INFO) << "\t Num. configurations with different self-collision result: " << num_different;
+}
 
 int main([[maybe_unused]] int argc, char **argv)
 {
@@ -14,6 +135,14 @@ int main([[maybe_unused]] int argc, char **argv)
 	ConfigurationReader::initConfiguration(project_path);
 
 	std::shared_ptr<robots::xArm6> robot { std::make_shared<robots::xArm6>(project_path + "/data/xarm6/xarm6.urdf") };
+	benchmarkForwardKinematics(robot, 100000);
+	for (size_t batch_size : { 8, 16, 64 })
+		benchmarkBatchSkeletons(robot, 100000 / batch_size * batch_size, batch_size);
+
+	std::shared_ptr<robots::CapsuleRobot> capsule_robot 
+		{ std::make_shared<robots::CapsuleRobot>(project_path + "/data/xarm6/xarm6.urdf", project_path + "/data/xarm6/xarm6_capsules.yaml") };
+	robot->setCapsulesRadius({ 0.047, 0.12, 0.11, 0.09, 0.05, 0.0380 });		// The same as in "xarm6_capsules.yaml"
+	benchmarkCapsuleRobot(robot, capsule_robot, 100000);
 
 	// LOG(INFO) << robot->getRobotTree().getNrOfSegments();
 	// LOG(INFO) << robot->getNumLinks();
@@ -20,6 +20,7 @@
 #include "RGBMTStarConfig.h"
 #include "DRGBTConfig.h"
 #include "SplinesConfig.h"
+#include "TreeConfig.h"
 
 class ConfigurationReader
 {
@@ -14,6 +14,7 @@ public:
     static size_t MAX_NUM_STATES;               // Maximal number of considered states
     static float MAX_PLANNING_TIME;             // Maximal algorithm runtime in [s]
     static size_t NUM_LAYERS;                   // Number of layers (extensions) for generating a generalized bur
+    static float NN_APPROX_EPS;                 // Allowed relative error of the nearest-neighbour search (0: exact search)
 };
 
 #endif //RPMPL_RGBTCONNECTCONFIG_H
\ No newline at end of file
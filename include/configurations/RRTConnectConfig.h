@@ -15,6 +15,7 @@ public:
     static float MAX_PLANNING_TIME;             // Maximal algorithm runtime in [s]
     static size_t MAX_EXTENSION_STEPS;          // Maximal number of extensions in connect procedure
     static float EPS_STEP;                      // Advancing step in C-space in [rad] used by RRT-based algorithms
+    static float NN_APPROX_EPS;                 // Allowed relative error of the nearest-neighbour search (0: exact search)
 };
 
 #endif //RPMPL_RRTCONNECTCONFIG_H
\ No newline at end of file
@@ -5,6 +5,8 @@
 #ifndef RPMPL_REALVECTORSPACECONFIG_H
 #define RPMPL_REALVECTORSPACECONFIG_H
 
+#include "StateSpaceType.h"
+
 typedef unsigned long size_t;
 
 class RealVectorSpaceConfig
@@ -12,6 +14,13 @@ class RealVectorSpaceConfig
 public:
     static float EQUALITY_THRESHOLD;                    // Threshold to determine whether two states are equal
     static size_t NUM_INTERPOLATION_VALIDITY_CHECKS;    // Number of discrete collision checks of the edge with the length of RRTConnectConfig::EPS_STEP
+    static base::EdgeCheckOrder EDGE_CHECK_ORDER;       // Order in which interpolated configurations of the edge are checked (Backward, Forward or Bisection)
+    static bool CERTIFIED_EDGE_VALIDATION;              // Whether parts of the edge proved collision-free using distance-to-obstacles and enclosing radii are not checked
+    static size_t BROAD_PHASE_THRESHOLD;                // Minimal number of box obstacles for which a uniform grid is used to cull far obstacles in collision checking (0: grid is not used)
+    static bool USE_DISTANCE_LOWER_BOUND;               // Whether distance to an obstacle is not computed if its lower bound (using AABBs) exceeds the current minimal distance or the obstacle tolerance
+    static bool WEIGHTED_METRIC;                        // Whether each joint is weighted by the radius of the robot part it moves (false: Euclidean metric)
+    static size_t STATE_POOL_CHUNK_SIZE;                // Number of states allocated at once from the memory pool of each planner (0: pool is not used)
+    static size_t KINEMATICS_CACHE_SIZE;                // Maximal size in [MB] of frames, skeletons and enclosing radii kept in states of each planner (0: all are kept)
 };
 
 #endif //RPMPL_REALVECTORSPACECONFIG_H
\ No newline at end of file
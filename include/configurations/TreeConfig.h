@@ -0,0 +1,15 @@
+#ifndef RPMPL_TREECONFIG_H
+#define RPMPL_TREECONFIG_H
+
+typedef unsigned long size_t;
+
+class TreeConfig
+{
+public:
+    static bool CONTIGUOUS_STORAGE;             // Whether coordinates and parents of all nodes are also stored in contiguous arrays
+    static size_t STATIC_KD_TREE_THRESHOLD;     // Number of nodes after which the dynamic Kd-tree is replaced by a static one, periodically rebuilt in the background (0: never)
+    static size_t KD_TREE_BUFFER_SIZE;          // Number of recently added nodes (searched linearly) after which the static Kd-tree is rebuilt
+    static size_t LINEAR_SEARCH_THRESHOLD;      // Maximal number of nodes that are searched linearly, before the Kd-tree is built (0: Kd-tree is always used)
+};
+
+#endif //RPMPL_TREECONFIG_H
\ No newline at end of file
@@ -15,6 +15,7 @@ namespace env
 		Box(const fcl::Vector3f &dim, const fcl::Vector3f &pos, const fcl::Quaternionf &rot, const std::string &label_ = "");
 		~Box() {}
 
+		inline std::shared_ptr<Object> clone() const override { return std::make_shared<Box>(*this); }
 	};
 }
 
@@ -12,6 +12,7 @@
 #include <yaml-cpp/node/parse.h>
 
 #include "Box.h"
+#include "Sphere.h"
 
 namespace env
 {
@@ -35,6 +36,7 @@ namespace env
 		inline float getBaseRadius() const { return base_radius; }
 		inline float getRobotMaxVel() const { return robot_max_vel; }
 		inline size_t getGroundIncluded() const { return ground_included; }
+		inline size_t getVersion() const { return version; }
 
 		void addObject(const std::shared_ptr<env::Object> object, const fcl::Vector3f &velocity = fcl::Vector3f::Zero(), 
 					   const fcl::Vector3f &acceleration = fcl::Vector3f::Zero());
@@ -52,6 +54,7 @@ namespace env
 		float base_radius;
 		float robot_max_vel;
 		size_t ground_included;
+		size_t version;											// Incremented whenever objects are added, removed or changed
 	};
 }
 
@@ -13,12 +13,16 @@
 
 namespace env
 {	
+	// An object belongs to at most one environment, whose version is increased whenever the object is changed.
 	class Object
 	{
 	public:
         Object() {}
+        Object(const Object &object);
         virtual ~Object() = 0;
 
+        virtual std::shared_ptr<Object> clone() const = 0;
+
         inline const std::string &getLabel() const { return label; }
 		inline std::shared_ptr<fcl::CollisionObject<float>> getCollObject() const { return coll_object; }
         inline const fcl::Vector3f &getPosition() const { return position; }
@@ -28,16 +32,17 @@ namespace env
         inline float getMaxAcc() const { return max_acc; }
 		inline float getMinDistTol() const { return min_dist_tol; }
         
-        inline void setLabel(const std::string &label_) { label = label_; } 
-		inline void setCollObject(const std::shared_ptr<fcl::CollisionObject<float>> coll_object_) { coll_object = coll_object_; }
+        inline void setLabel(const std::string &label_) { label = label_; updateVersion(); } 
+		inline void setCollObject(const std::shared_ptr<fcl::CollisionObject<float>> coll_object_) { coll_object = coll_object_; updateVersion(); }
         void setPosition(const fcl::Vector3f &position_);
-		inline void setVelocity(const fcl::Vector3f &velocity_) { velocity = velocity_; }
-		inline void setAcceleration(const fcl::Vector3f &acceleration_) { acceleration = acceleration_; }
-		inline void setMaxVel(float max_vel_) { max_vel = max_vel_; }
-		inline void setMaxAcc(float max_acc_) { max_acc = max_acc_; }
-		inline void setMinDistTol(float min_dist_tol_) { min_dist_tol = min_dist_tol_; }
+		inline void setVelocity(const fcl::Vector3f &velocity_) { velocity = velocity_; updateVersion(); }
+		inline void setAcceleration(const fcl::Vector3f &acceleration_) { acceleration = acceleration_; updateVersion(); }
+		inline void setMaxVel(float max_vel_) { max_vel = max_vel_; updateVersion(); }
+		inline void setMaxAcc(float max_acc_) { max_acc = max_acc_; updateVersion(); }
+		inline void setMinDistTol(float min_dist_tol_) { min_dist_tol = min_dist_tol_; updateVersion(); }
 
         friend std::ostream &operator<<(std::ostream &os, const std::shared_ptr<env::Object> obj);
+        friend class Environment;
 
 	protected:
         std::string label;
@@ -48,6 +53,9 @@ namespace env
 		float max_vel; 										    	// Maximal velocity in [m/s]
 		float max_acc; 									        	// Maximal acceleration in [m/s²]
 		float min_dist_tol; 										// Minimal distance tolerance for a static obstacle to not be included into a dynamic scene	
+		size_t *env_version { nullptr };							// Version of the environment containing the object (nullptr: none)
+
+		inline void updateVersion() { if (env_version != nullptr) (*env_version)++; }
 	};
 }
 
@@ -0,0 +1,23 @@
+#ifndef RPMPL_SPHERE_H
+#define RPMPL_SPHERE_H
+
+#include "Object.h"
+
+namespace env
+{	
+	class Sphere : public Object
+	{
+	public:
+		Sphere(float radius_, const fcl::Vector3f &pos, const std::string &label_ = "");
+		~Sphere() {}
+
+		inline std::shared_ptr<Object> clone() const override { return std::make_shared<Sphere>(*this); }
+
+		inline float getRadius() const { return radius; }
+
+	private:
+		float radius;											// Radius in [m]
+	};
+}
+
+#endif //RPMPL_SPHERE_H
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include "StateSpace.h"
 #include "PlannerInfo.h"
 #include "PlanningTypes.h"
+#include "RealVectorSpaceConfig.h"
 
 namespace planning
 {
@@ -26,7 +27,7 @@ namespace planning
 		
 		inline planning::PlannerType getPlannerType() const { return planner_type; }
 		inline std::shared_ptr<base::StateSpace> getStateSpace() const { return ss; }
-		inline std::shared_ptr<PlannerInfo> getPlannerInfo() const { return planner_info; }
+		std::shared_ptr<PlannerInfo> getPlannerInfo() const;
 		virtual const std::vector<std::shared_ptr<base::State>> &getPath() const = 0;
 
 		virtual bool solve() = 0;
@@ -43,6 +44,11 @@ namespace planning
 		std::vector<std::shared_ptr<base::State>> path;
 		std::chrono::steady_clock::time_point time_alg_start;		// Start time point of the used algorithm
 		std::chrono::steady_clock::time_point time_iter_start;   	// Start time point at each iteration
+		std::shared_ptr<base::StatePool> state_pool;				// Memory pool for states created by the planner (nullptr if not owned)
+		std::shared_ptr<base::KinematicsCache> kinematics_cache;	// Cache of kinematic quantities of states used by the planner (nullptr if not owned)
+
+		void initStatePool();
+		void initKinematicsCache();
 	};
 }
 
@@ -18,6 +18,8 @@ protected:
 	float planning_time;
 	size_t num_collision_queries;
 	size_t num_distance_queries;
+	size_t num_kinematics_cache_hits;				// Number of queries for frames, skeleton or enclosing radii already stored in a state
+	size_t num_kinematics_cache_misses;				// Number of queries for which they had to be computed
 	size_t num_states;
 	size_t num_iterations;
 	bool success_state;								// Did the planner succeed to find a solution?
@@ -35,6 +37,8 @@ public:
 	inline void setPlanningTime(float planning_time_) { planning_time = planning_time_; }
 	inline void setNumCollisionQueries(size_t num_collision_queries_) { num_collision_queries = num_collision_queries_; }
 	inline void setNumDistanceQueries(size_t num_distance_queries_) { num_distance_queries = num_distance_queries_; }
+	inline void setNumKinematicsCacheHits(size_t num_kinematics_cache_hits_) { num_kinematics_cache_hits = num_kinematics_cache_hits_; }
+	inline void setNumKinematicsCacheMisses(size_t num_kinematics_cache_misses_) { num_kinematics_cache_misses = num_kinematics_cache_misses_; }
 	inline void setNumStates(size_t num_states_) { num_states = num_states_; }
 	inline void setNumIterations(size_t num_iterations_) { num_iterations = num_iterations_; }
 	inline void setSuccessState(bool success_state_) { success_state = success_state_; }
@@ -48,6 +52,13 @@ public:
 	inline float getPlanningTime() const { return planning_time; }
 	inline size_t getNumCollisionQueries() const { return num_collision_queries; }
 	inline size_t getNumDistanceQueries() const { return num_distance_queries; }
+	inline size_t getNumKinematicsCacheHits() const { return num_kinematics_cache_hits; }
+	inline size_t getNumKinematicsCacheMisses() const { return num_kinematics_cache_misses; }
+	inline float getKinematicsCacheHitRate() const 
+	{ 
+		return num_kinematics_cache_hits + num_kinematics_cache_misses > 0 ? 
+			float(num_kinematics_cache_hits) / (num_kinematics_cache_hits + num_kinematics_cache_misses) : 0; 
+	}
 	inline size_t getNumStates() const { return num_states; }
 	inline size_t getNumIterations() const { return num_iterations; }
 	inline bool getSuccessState() const { return success_state; }
@@ -16,13 +16,16 @@
 #include <kdl/treefksolverpos_recursive.hpp>
 
 #include "State.h"
+#include "ForwardKinematics.h"
+#include "KinematicsCache.h"
+#include "CollisionAndDistance.h"
 
 namespace robots
 {
 	class AbstractRobot
 	{
 	public:
-		explicit AbstractRobot() { configuration = nullptr; }
+		explicit AbstractRobot() { configuration = nullptr; kinematics_cache = nullptr; }
 		virtual ~AbstractRobot() = 0;
 		
 		inline const std::string &getType() const { return type; }
@@ -41,6 +44,8 @@ namespace robots
 		inline bool getSelfCollisionChecking() const { return self_collision_checking; }
 		inline float getGripperLength() const { return gripper_length; }
 		inline size_t getGroundIncluded() const { return ground_included; }
+		inline std::shared_ptr<base::KinematicsCache> getKinematicsCache() const { return kinematics_cache; }
+		inline const std::vector<std::pair<size_t, size_t>> &getSelfCollisionPairs() const { return self_collision_pairs; }
 
 		inline void setConfiguration(const std::shared_ptr<base::State> configuration_) { configuration = configuration_; }
 		inline virtual void setCapsulesRadius(const std::vector<float> &capsules_radius_) { capsules_radius = capsules_radius_; }
@@ -50,15 +55,18 @@ namespace robots
 		inline void setSelfCollisionChecking(bool self_collision_checking_) { self_collision_checking = self_collision_checking_; }
 		inline void setGripperLength(float gripper_length_) { gripper_length = gripper_length_; }
 		inline void setGroundIncluded(size_t ground_included_) { ground_included = ground_included_; }
+		inline void setKinematicsCache(const std::shared_ptr<base::KinematicsCache> kinematics_cache_) { kinematics_cache = kinematics_cache_; }
 
 		virtual void setState(const std::shared_ptr<base::State> q) = 0;
 		virtual std::shared_ptr<std::vector<KDL::Frame>> computeForwardKinematics(const std::shared_ptr<base::State> q) = 0;
 		virtual std::shared_ptr<base::State> computeInverseKinematics(const KDL::Rotation &R, const KDL::Vector &p,
 																	  const std::shared_ptr<base::State> q_init = nullptr) = 0;
 		virtual std::shared_ptr<Eigen::MatrixXf> computeSkeleton(const std::shared_ptr<base::State> q) = 0;
+		virtual void computeSkeleton(const Eigen::VectorXf &q_coord, Eigen::MatrixXf &skeleton) = 0;
+		virtual void computeSkeletons(const BatchSoA &q_coords, BatchSoA &skeletons);
 		virtual std::shared_ptr<Eigen::MatrixXf> computeEnclosingRadii(const std::shared_ptr<base::State> q) = 0;
-		virtual bool checkSelfCollision(const std::shared_ptr<base::State> q1, std::shared_ptr<base::State> &q2) = 0;
-		virtual bool checkSelfCollision(const std::shared_ptr<base::State> q) = 0;
+		virtual bool checkSelfCollision(const std::shared_ptr<base::State> q1, std::shared_ptr<base::State> &q2);
+		virtual bool checkSelfCollision(const std::shared_ptr<base::State> q);
 
 	protected:
 		std::string type;
@@ -73,6 +81,24 @@ namespace robots
 		bool self_collision_checking;
 		float gripper_length;
 		size_t ground_included;
+		std::shared_ptr<base::KinematicsCache> kinematics_cache;	// Cache which bounds the memory of quantities stored in states (nullptr: all are kept)
+		std::vector<std::pair<size_t, size_t>> self_collision_pairs;	// Pairs of links which are checked for self-collision
+		base::NearestPoints nearest_pts;								// Scratch nearest points of two capsules
+
+		std::shared_ptr<base::State> solveInverseKinematics(const KDL::Chain &chain, const KDL::Frame &goal_frame, 
+															const std::shared_ptr<base::State> q_init);
+		bool checkSelfCollision(const std::shared_ptr<base::State> q1, std::shared_ptr<base::State> &q2, const std::vector<float> &steps);
+		bool checkSelfCollision(const std::shared_ptr<base::State> q, const std::vector<bool> &skip_checking);
+		float computeCapsulesDistance(const std::shared_ptr<base::State> q, size_t link1_idx, size_t link2_idx);
+
+		// Check self-collision between the real geometry of two links, when their capsules collide.
+		// By default, capsules are the real geometry of links.
+		inline virtual bool checkRealSelfCollision([[maybe_unused]] const std::shared_ptr<base::State> q, 
+												   [[maybe_unused]] size_t link1_idx, [[maybe_unused]] size_t link2_idx) { return true; }
+
+		// Record in 'kinematics_cache' (if set) whether a quantity of 'q' is already stored ('hit') or computed and stored now
+		inline void cacheHit(const std::shared_ptr<base::State> q) { if (kinematics_cache != nullptr) kinematics_cache->hit(q); }
+		inline void cacheMiss(const std::shared_ptr<base::State> q) { if (kinematics_cache != nullptr) kinematics_cache->miss(q); }
 	};
 }
 
@@ -0,0 +1,83 @@
+#ifndef RPMPL_CAPSULEROBOT_H
+#define RPMPL_CAPSULEROBOT_H
+
+#include "AbstractRobot.h"
+#include "RealVectorSpace.h"
+#include "RRTConnectConfig.h"
+#include "ForwardKinematics.h"
+
+#include <kdl_parser/kdl_parser.hpp>
+#include <kdl/frames_io.hpp>
+#include <kdl/treefksolverpos_recursive.hpp>
+#include <urdf/model.h>
+#include <glog/logging.h>
+#include <stl_reader.h>
+#include <yaml-cpp/yaml.h>
+
+namespace robots
+{
+	// Serial robot whose links are approximated by capsules, where the capsule model is not hand-coded,
+	// but it is read from the URDF file 'robot_desc' and a YAML file 'capsules_desc' (see 'data/xarm6/xarm6_capsules.yaml'),
+	// which contains the chain root and tip, skeleton points, capsules radii and self-collision pairs of links.
+	// Each chain segment with a collision mesh in URDF is one link, so there must be 'num_links + 1' skeleton points.
+	class CapsuleRobot : public AbstractRobot
+	{
+	public:
+		CapsuleRobot(const std::string &robot_desc, const std::string &capsules_desc, size_t ground_included_ = 0);
+		~CapsuleRobot();
+
+		const KDL::Tree &getRobotTree() const { return robot_tree; }
+
+		void setState(std::shared_ptr<base::State> q) override;
+		void setCapsulesRadius(const std::vector<float> &capsules_radius_) override;
+		std::shared_ptr<std::vector<KDL::Frame>> computeForwardKinematics(std::shared_ptr<base::State> q) override;
+		void computeForwardKinematics(const Eigen::VectorXf &q_coord, std::vector<KDL::Frame> &frames_fk);
+		std::shared_ptr<base::State> computeInverseKinematics(const KDL::Rotation &R, const KDL::Vector &p,
+															  std::shared_ptr<base::State> q_init = nullptr) override;
+		std::shared_ptr<Eigen::MatrixXf> computeSkeleton(std::shared_ptr<base::State> q) override;
+		void computeSkeleton(const Eigen::VectorXf &q_coord, Eigen::MatrixXf &skeleton) override;
+		void computeSkeletons(const BatchSoA &q_coords, BatchSoA &skeletons) override;
+		std::shared_ptr<Eigen::MatrixXf> computeEnclosingRadii(const std::shared_ptr<base::State> q) override;
+
+	private:
+		// Point which is rigidly attached to the frame of the chain segment 'frame' (-1 for the chain root)
+		struct SkeletonPoint
+		{
+			int frame;
+			KDL::Vector offset;					// Offset in the frame
+		};
+
+		// Joint axis, which is fixed in the frame of the chain segment 'frame' (-1 for the chain root)
+		struct JointAxis
+		{
+			int frame;
+			KDL::Vector origin;					// Point on the axis in the frame
+			KDL::Vector axis;					// Direction of the axis in the frame
+			bool is_revolute;
+		};
+
+		void readCapsules(const std::string &capsules_desc);
+		inline const KDL::Frame &getFrame(const std::vector<KDL::Frame> &frames, int idx) const { return idx < 0 ? base_frame : frames[idx]; }
+		void computeSkeleton(const std::vector<KDL::Frame> &frames, Eigen::MatrixXf &skeleton);
+		bool checkRealSelfCollision(const std::shared_ptr<base::State> q, size_t link1_idx, size_t link2_idx) override;
+		bool checkCollisionFCL(const std::unique_ptr<fcl::CollisionObjectf> &obj1, const std::unique_ptr<fcl::CollisionObjectf> &obj2);
+		fcl::Transform3f KDL2fcl(const KDL::Frame &in);
+
+		KDL::Tree robot_tree;
+		KDL::Chain robot_chain;
+		std::string chain_root;
+		std::string chain_tip;
+		KDL::Frame base_frame;					// Frame of the chain root with respect to the tree root
+		size_t num_frames;						// Number of chain segments whose frames are computed by FK
+		std::vector<size_t> link_segments;		// Index of the chain segment of each link
+		std::vector<SkeletonPoint> skeleton_points;
+		std::vector<JointAxis> joint_axes;
+		float tool_length;						// Length of the tool which ends at the last skeleton point (0: no tool)
+		std::vector<float> capsules_radius_new;
+		robots::ForwardKinematics fk_solver;
+		std::vector<KDL::Frame> frames_scratch;	// Scratch frames for configurations that are not stored as states
+		BatchSoA frames_batch_scratch;			// Scratch frames for a batch of configurations
+	};
+}
+
+#endif //RPMPL_CAPSULEROBOT_H
\ No newline at end of file
@@ -0,0 +1,56 @@
+#ifndef RPMPL_FORWARDKINEMATICS_H
+#define RPMPL_FORWARDKINEMATICS_H
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <Eigen/Dense>
+#include <kdl/frames.hpp>
+#include <kdl/treefksolverpos_recursive.hpp>
+
+namespace robots
+{
+	// Batch of N configurations (or quantities computed from them) in SoA layout, where each row is one coordinate,
+	// and each column is one configuration, so operations on a row are vectorised across configurations.
+	typedef Eigen::Array<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> BatchSoA;
+
+	// Forward kinematics of a serial chain, which is precomputed from 'KDL::Tree' only once, 
+	// such that frames of all segments are computed in a single forward pass using fixed-size float matrices.
+	class ForwardKinematics
+	{
+	public:
+		typedef Eigen::Array<float, 1, 8> Chunk;	// Chunk of configurations processed together in 'computeBatch'
+
+		ForwardKinematics() {}
+		ForwardKinematics(const KDL::Tree &tree, const std::string &chain_root, const std::string &chain_tip);
+		~ForwardKinematics() {}
+
+		inline size_t getNumSegments() const { return segments.size(); }
+		inline size_t getNumJoints() const { return num_joints; }
+
+		void compute(const Eigen::VectorXf &q_coord, std::vector<KDL::Frame> &frames) const;
+		void computeBatch(const BatchSoA &q_coords, BatchSoA &frames, size_t num_frames) const;
+
+	private:
+		enum class JointType { Fixed, Revolute, Prismatic };
+
+		// Pose of the segment tip with respect to its parent is precomputed in terms of the joint value 'q' as follows:
+		// R = cos(q) A + sin(q) B + C, and p = cos(q) u + sin(q) v + w for a revolute joint,
+		// R = C, and p = q axis + w for a prismatic joint, and R = C, and p = w for a fixed joint.
+		// The fixed pose of the chain root with respect to the tree root is folded into the first segment.
+		struct Segment
+		{
+			JointType joint_type;
+			Eigen::Vector3f axis;				// Joint axis in the parent frame
+			Eigen::Matrix3f A, B, C;
+			Eigen::Vector3f u, v, w;
+		};
+
+		void computeSegmentPose(const Segment &segment, float q, Eigen::Matrix3f &R, Eigen::Vector3f &p) const;
+
+		std::vector<Segment> segments;
+		size_t num_joints;
+	};
+}
+
+#endif //RPMPL_FORWARDKINEMATICS_H
\ No newline at end of file
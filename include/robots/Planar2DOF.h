@@ -9,6 +9,7 @@
 #include "AbstractRobot.h"
 #include "Environment.h"
 #include "RealVectorSpaceState.h"
+#include "ForwardKinematics.h"
 
 #include <kdl_parser/kdl_parser.hpp>
 #include <kdl/frames_io.hpp>
@@ -28,9 +29,13 @@ namespace robots
 
 		void setState(const std::shared_ptr<base::State> q) override;
 		std::shared_ptr<std::vector<KDL::Frame>> computeForwardKinematics(const std::shared_ptr<base::State> q) override;
+		void computeForwardKinematics(const Eigen::VectorXf &q_coord, std::vector<KDL::Frame> &frames_fk);
+		void computeForwardKinematicsKDL(const Eigen::VectorXf &q_coord, std::vector<KDL::Frame> &frames_fk);
 		std::shared_ptr<base::State> computeInverseKinematics(const KDL::Rotation &R, const KDL::Vector &p, 
 															  const std::shared_ptr<base::State> q_init = nullptr) override;
 		std::shared_ptr<Eigen::MatrixXf> computeSkeleton(const std::shared_ptr<base::State> q) override;
+		void computeSkeleton(const Eigen::VectorXf &q_coord, Eigen::MatrixXf &skeleton) override;
+		void computeSkeletons(const BatchSoA &q_coords, BatchSoA &skeletons) override;
 		std::shared_ptr<Eigen::MatrixXf> computeEnclosingRadii(const std::shared_ptr<base::State> q) override;
 		virtual bool checkSelfCollision(const std::shared_ptr<base::State> q1, std::shared_ptr<base::State> &q2) override;
 		virtual bool checkSelfCollision(const std::shared_ptr<base::State> q) override;
@@ -44,6 +49,11 @@ namespace robots
 		std::vector<KDL::Frame> init_poses;
 		KDL::Tree robot_tree;
 		KDL::Chain robot_chain;
+		robots::ForwardKinematics fk_solver;		// Closed-form FK solver used in hot paths
+		std::unique_ptr<KDL::TreeFkSolverPos_recursive> tree_fk_solver;	// KDL FK solver kept as a reference
+		KDL::JntArray joint_pos;					// Scratch joint positions used by KDL FK solver
+		std::vector<KDL::Frame> frames_scratch;		// Scratch frames for configurations that are not stored as states
+		BatchSoA frames_batch_scratch;				// Scratch frames for a batch of configurations
 	};
 }
 
@@ -9,13 +9,11 @@
 #include "AbstractRobot.h"
 #include "RealVectorSpace.h"
 #include "RRTConnectConfig.h"
+#include "ForwardKinematics.h"
 
 #include <kdl_parser/kdl_parser.hpp>
 #include <kdl/frames_io.hpp>
 #include <kdl/treefksolverpos_recursive.hpp>
-#include <kdl/chainfksolverpos_recursive.hpp>
-#include <kdl/chainiksolvervel_pinv.hpp>
-#include <kdl/chainiksolverpos_nr.hpp>
 #include <urdf/model.h>
 #include <glog/logging.h>
 #include <stl_reader.h>
@@ -33,17 +31,18 @@ namespace robots
 		void setState(std::shared_ptr<base::State> q) override;
 		void setCapsulesRadius(const std::vector<float> &capsules_radius_) override;
 		std::shared_ptr<std::vector<KDL::Frame>> computeForwardKinematics(std::shared_ptr<base::State> q) override;
+		void computeForwardKinematics(const Eigen::VectorXf &q_coord, std::vector<KDL::Frame> &frames_fk);
+		void computeForwardKinematicsKDL(const Eigen::VectorXf &q_coord, std::vector<KDL::Frame> &frames_fk);
 		std::shared_ptr<base::State> computeInverseKinematics(const KDL::Rotation &R, const KDL::Vector &p, 
 															  std::shared_ptr<base::State> q_init = nullptr) override;
 		std::shared_ptr<Eigen::MatrixXf> computeSkeleton(std::shared_ptr<base::State> q) override;
+		void computeSkeleton(const Eigen::VectorXf &q_coord, Eigen::MatrixXf &skeleton) override;
+		void computeSkeletons(const BatchSoA &q_coords, BatchSoA &skeletons) override;
 		std::shared_ptr<Eigen::MatrixXf> computeEnclosingRadii(const std::shared_ptr<base::State> q) override;
-		bool checkSelfCollision(const std::shared_ptr<base::State> q1, std::shared_ptr<base::State> &q2) override;
-		bool checkSelfCollision(const std::shared_ptr<base::State> q) override;
 
 	private:
-		bool checkSelfCollision(const std::shared_ptr<base::State> q, std::vector<bool> &skip_checking);
-		float computeCapsulesDistance(const std::shared_ptr<base::State> q, size_t link1_idx, size_t link2_idx);
-		bool checkRealSelfCollision(const std::shared_ptr<base::State> q, size_t link1_idx, size_t link2_idx);
+		void computeSkeleton(const std::vector<KDL::Frame> &frames, Eigen::MatrixXf &skeleton);
+		bool checkRealSelfCollision(const std::shared_ptr<base::State> q, size_t link1_idx, size_t link2_idx) override;
 		bool checkCollisionFCL(const std::unique_ptr<fcl::CollisionObjectf> &obj1, const std::unique_ptr<fcl::CollisionObjectf> &obj2);
 		fcl::Transform3f KDL2fcl(const KDL::Frame &in);
 		KDL::Frame fcl2KDL(const fcl::Transform3f &in);
@@ -53,6 +52,11 @@ namespace robots
 		KDL::Tree robot_tree;
 		KDL::Chain robot_chain;
 		std::vector<float> capsules_radius_new;
+		robots::ForwardKinematics fk_solver;		// Closed-form FK solver used in hot paths
+		std::unique_ptr<KDL::TreeFkSolverPos_recursive> tree_fk_solver;	// KDL FK solver kept as a reference
+		KDL::JntArray joint_pos;					// Scratch joint positions used by KDL FK solver
+		std::vector<KDL::Frame> frames_scratch;		// Scratch frames for configurations that are not stored as states
+		BatchSoA frames_batch_scratch;				// Scratch frames for a batch of configurations
 	};
 }
 
@@ -13,10 +13,12 @@
 
 #include "Environment.h"
 #include "RealVectorSpaceFCL.h"
+#include "RealVectorSpaceN.h"
 #include "RealVectorSpaceState.h"
 #include "Planar2DOF.h"
 #include "Planar10DOF.h"
 #include "xArm6.h"
+#include "CapsuleRobot.h"
 #include <yaml-cpp/yaml.h>
 
 namespace scenario
@@ -46,6 +48,10 @@ namespace scenario
         std::shared_ptr<base::State> q_goal;
         base::StateSpaceType state_space_type;
         size_t num_dimensions;         // Number of dimensions of the state-space (also 'num_DOFs' of the used robot)
+
+        template <class Space>
+        static std::shared_ptr<base::StateSpace> createStateSpace(size_t num_DOFs, const std::shared_ptr<robots::AbstractRobot> robot, 
+                                                                  const std::shared_ptr<env::Environment> env);
 	};
 }
 
@@ -0,0 +1,61 @@
+#ifndef RPMPL_KINEMATICSCACHE_H
+#define RPMPL_KINEMATICSCACHE_H
+
+#include <list>
+#include <unordered_map>
+#include <memory>
+
+#include "State.h"
+
+namespace base
+{
+	// Bounded LRU cache of kinematic quantities (frames, skeleton and enclosing radii) that are stored in states.
+	// Quantities are still kept in each state, but the cache tracks states holding them in the order they are used, 
+	// and releases quantities of the least recently used states when their total size exceeds 'max_size'.
+	// Released quantities are computed again when needed. A destroyed state removes itself from the cache, 
+	// so the cache holds neither destroyed states nor their sizes. The cache is not thread-safe.
+	class KinematicsCache
+	{
+	private:
+		struct Entry
+		{
+			base::State *state;			// Living state, which is tracked until it is destroyed or its quantities are released
+			size_t size;				// Size of quantities of 'state' in [B]
+		};
+
+		size_t max_size;				// Maximal total size of cached quantities in [B]
+		size_t size;					// Current total size of cached quantities in [B]
+		std::list<Entry> entries;		// Entries ordered from the most to the least recently used
+		std::unordered_map<const base::State*, std::list<Entry>::iterator> entry_indices;
+		size_t num_hits;				// Number of queries for which quantities were already stored in the state
+		size_t num_misses;				// Number of queries for which quantities had to be computed
+		size_t num_evictions;			// Number of states whose quantities were released
+
+	public:
+		KinematicsCache(size_t max_size_);
+		KinematicsCache(const KinematicsCache &) = delete;
+		KinematicsCache &operator=(const KinematicsCache &) = delete;
+		~KinematicsCache();
+
+		inline size_t getMaxSize() const { return max_size; }
+		inline size_t getSize() const { return size; }
+		inline size_t getNumEntries() const { return entries.size(); }
+		inline size_t getNumHits() const { return num_hits; }
+		inline size_t getNumMisses() const { return num_misses; }
+		inline size_t getNumEvictions() const { return num_evictions; }
+		inline float getHitRate() const { return num_hits + num_misses > 0 ? float(num_hits) / (num_hits + num_misses) : 0; }
+
+		void hit(const std::shared_ptr<base::State> q);
+		void miss(const std::shared_ptr<base::State> q);
+		void remove(const base::State *q);
+		void clear();
+
+	private:
+		void update(const std::shared_ptr<base::State> q);
+		void evict();
+		static void release(base::State *q);
+		static size_t computeSize(const std::shared_ptr<base::State> q);
+	};
+}
+
+#endif //RPMPL_KINEMATICSCACHE_H
\ No newline at end of file
@@ -14,6 +14,8 @@
 #include "StateSpaceType.h"
 namespace base
 {
+	class KinematicsCache;
+
 	class State
 	{
 	public:
@@ -35,6 +37,7 @@ namespace base
 		std::shared_ptr<std::vector<KDL::Frame>> frames;				// All frames of the robot
 		std::shared_ptr<Eigen::MatrixXf> skeleton;						// Skeleton points of the robot
 		std::shared_ptr<Eigen::MatrixXf> enclosing_radii; 				// Matrix containing all enclosing radii (row: from which skeleton point, column: to which skeleton point)
+		base::KinematicsCache *kinematics_cache { nullptr };			// Cache which tracks quantities of the state (nullptr: not tracked)
 		
 	public:
 		State() {}
@@ -58,6 +61,7 @@ namespace base
 		inline std::shared_ptr<std::vector<KDL::Frame>> getFrames() const { return frames; }
 		inline std::shared_ptr<Eigen::MatrixXf> getSkeleton() const { return skeleton; }
 		inline std::shared_ptr<Eigen::MatrixXf> getEnclosingRadii() const { return enclosing_radii; }
+		inline base::KinematicsCache *getKinematicsCache() const { return kinematics_cache; }
 
 		inline void setStateSpaceType(base::StateSpaceType state_space_type_) { state_space_type = state_space_type_; }
 		inline void setNumDimensions(size_t num_dimensions_) { num_dimensions = num_dimensions_; }
@@ -75,6 +79,7 @@ namespace base
 		inline void setFrames(const std::shared_ptr<std::vector<KDL::Frame>> frames_) { frames = frames_; }
 		inline void setSkeleton(const std::shared_ptr<Eigen::MatrixXf> skeleton_) { skeleton = skeleton_; }
 		inline void setEnclosingRadii(const std::shared_ptr<Eigen::MatrixXf> enclosing_radii_) { enclosing_radii = enclosing_radii_; }
+		inline void setKinematicsCache(base::KinematicsCache *kinematics_cache_) { kinematics_cache = kinematics_cache_; }
 
 		void addChild(const std::shared_ptr<State> child);
 		friend std::ostream &operator<<(std::ostream &os, const std::shared_ptr<base::State> state);
@@ -0,0 +1,64 @@
+#ifndef RPMPL_STATEPOOL_H
+#define RPMPL_STATEPOOL_H
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <algorithm>
+
+namespace base
+{
+	// Memory pool for states (together with their control blocks) created while a planner is running.
+	// Memory is obtained in chunks of 'chunk_size' equally sized blocks, and freed blocks are reused. 
+	// All chunks are released at once when the pool is destroyed, i.e., when the planner and all states allocated from the pool 
+	// are destroyed, since each state holds the pool through its allocator. The pool is not thread-safe.
+	class StatePool
+	{
+	private:
+		size_t chunk_size;				// Number of blocks in each chunk
+		size_t block_size;				// Size of each block in [B] (determined by the first allocation)
+		std::vector<char*> chunks;		// All allocated chunks
+		char *next_block;				// Next unused block in the last chunk
+		char *chunk_end;				// End of the last chunk
+		void *free_blocks;				// Singly-linked list of freed blocks
+		size_t num_blocks;				// Number of blocks currently in use
+
+	public:
+		StatePool(size_t chunk_size_);
+		StatePool(const StatePool &) = delete;
+		StatePool &operator=(const StatePool &) = delete;
+		~StatePool();
+
+		inline size_t getNumChunks() const { return chunks.size(); }
+		inline size_t getNumBlocks() const { return num_blocks; }
+
+		void *allocate(size_t size);
+		void deallocate(void *ptr, size_t size);
+	};
+
+	// Allocator that can be passed to 'std::allocate_shared' in order to allocate a state from 'StatePool'
+	template <class T>
+	class StatePoolAllocator
+	{
+	public:
+		typedef T value_type;
+
+		StatePoolAllocator(const std::shared_ptr<base::StatePool> pool_) : pool(pool_) {}
+		template <class U>
+		StatePoolAllocator(const StatePoolAllocator<U> &other) : pool(other.getPool()) {}
+
+		inline std::shared_ptr<base::StatePool> getPool() const { return pool; }
+		inline T *allocate(size_t n) { return static_cast<T*>(pool->allocate(n * sizeof(T))); }
+		inline void deallocate(T *ptr, size_t n) { pool->deallocate(ptr, n * sizeof(T)); }
+
+		template <class U>
+		inline bool operator==(const StatePoolAllocator<U> &other) const { return pool == other.getPool(); }
+		template <class U>
+		inline bool operator!=(const StatePoolAllocator<U> &other) const { return pool != other.getPool(); }
+
+	private:
+		std::shared_ptr<base::StatePool> pool;
+	};
+}
+
+#endif //RPMPL_STATEPOOL_H
\ No newline at end of file
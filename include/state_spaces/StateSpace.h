@@ -10,6 +10,7 @@
 #include "StateSpaceType.h"
 #include "AbstractRobot.h"
 #include "Environment.h"
+#include "StatePool.h"
 
 namespace base
 {
@@ -29,6 +30,10 @@ namespace base
 		
 		inline void setStateSpaceType(base::StateSpaceType state_space_type_) { state_space_type = state_space_type_; };
 		inline size_t getNumDimensions() { return num_dimensions; }
+		inline const Eigen::VectorXf &getMetricWeights() const { return metric_weights; }
+		inline void setMetricWeights(const Eigen::VectorXf &metric_weights_) { metric_weights = metric_weights_; }
+		inline std::shared_ptr<base::StatePool> getStatePool() const { return state_pool; }
+		inline void setStatePool(const std::shared_ptr<base::StatePool> state_pool_) { state_pool = state_pool_; }
 		inline virtual base::StateSpaceType getStateSpaceType() const { return state_space_type; };
 		virtual std::shared_ptr<base::State> getRandomState(const std::shared_ptr<base::State> q_center = nullptr) = 0;
 		virtual std::shared_ptr<base::State> getNewState(const Eigen::VectorXf &coord) = 0;
@@ -50,8 +55,13 @@ namespace base
 		virtual bool isValid(const std::shared_ptr<base::State> q) = 0;
 		virtual bool isValid(const std::shared_ptr<base::State> q1, const std::shared_ptr<base::State> q2) = 0;
 		virtual float computeDistance(const std::shared_ptr<base::State> q, bool compute_again = false) = 0;
+		virtual bool isDistanceGreater(const std::shared_ptr<base::State> q, float d_threshold) = 0;
 		virtual float computeDistanceUnderestimation(const std::shared_ptr<base::State> q, 
 			const std::shared_ptr<std::vector<Eigen::MatrixXf>> nearest_points) = 0;
+
+	protected:
+		Eigen::VectorXf metric_weights;		// Weight of each dimension used by 'getNorm' and trees (empty: Euclidean metric)
+		std::shared_ptr<base::StatePool> state_pool;	// Pool from which new states are allocated (nullptr: heap is used)
 	};
 }
 
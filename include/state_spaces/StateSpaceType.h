@@ -7,6 +7,7 @@
 
 #include <ostream>
 #include <string>
+#include <unordered_map>
 
 namespace base
 {
@@ -19,7 +20,22 @@ namespace base
 		SO3
 	};
 
+	enum class EdgeCheckOrder
+	{
+		Backward,	// From 'q2' towards 'q1'
+		Forward,	// From 'q1' towards 'q2'
+		Bisection	// 'q2' first, then midpoints of remaining intervals level by level (van der Corput sequence)
+	};
+
+	static std::unordered_map<std::string, base::EdgeCheckOrder> edge_check_order_map = 
+	{
+		{ "Backward", base::EdgeCheckOrder::Backward },
+		{ "Forward", base::EdgeCheckOrder::Forward },
+		{ "Bisection", base::EdgeCheckOrder::Bisection }
+	};
+
 	std::ostream &operator<<(std::ostream &os, const base::StateSpaceType &type);
+	std::ostream &operator<<(std::ostream &os, const base::EdgeCheckOrder &order);
 }
 
 #endif //RPMPL_STATESPACETYPE_H
\ No newline at end of file
@@ -0,0 +1,42 @@
+#ifndef RPMPL_STATICKDTREE_H
+#define RPMPL_STATICKDTREE_H
+
+#include <nanoflann.hpp>
+#include <vector>
+#include <memory>
+
+namespace base
+{
+	class StaticKdTree;
+	typedef nanoflann::KDTreeSingleIndexAdaptor
+			<nanoflann::L2_Simple_Adaptor<float, base::StaticKdTree>, base::StaticKdTree> StaticKdTreeIndex;
+
+	// Balanced Kd-tree, which is built only once over its own copy of coordinates of the first 'getNumStates()' states of a tree.
+	// Since it does not read the tree storage, it can be built in the background while the tree is growing.
+	class StaticKdTree
+	{
+	private:
+		std::vector<float> coords;					// Coordinates of all states packed one after another
+		size_t num_dimensions;
+		size_t num_states;
+		std::shared_ptr<base::StaticKdTreeIndex> index;
+
+	public:
+		StaticKdTree(std::vector<float> &&coords_, size_t num_dimensions_);
+		StaticKdTree(const StaticKdTree &) = delete;	// 'index' refers to this object
+		~StaticKdTree() {}
+
+		inline size_t getNumStates() const { return num_states; }
+
+		template <class RESULTSET>
+		inline void findNeighbors(RESULTSET &result_set, const float *q, const nanoflann::SearchParams &params) const 
+			{ index->findNeighbors(result_set, q, params); }
+
+		template <class BBOX> 
+        bool kdtree_get_bbox(BBOX& /* bb */) const { return false; }
+		inline size_t kdtree_get_point_count() const { return num_states; }
+		inline float kdtree_get_pt(const size_t idx, const size_t dim) const { return coords[idx * num_dimensions + dim]; }
+	};
+}
+
+#endif //RPMPL_STATICKDTREE_H
\ No newline at end of file
@@ -6,15 +6,22 @@
 #define RPMPL_TREE_H
 
 #include <nanoflann.hpp>
+#include <functional>
+#include <thread>
+#include <algorithm>
+#include <future>
 
 #include "State.h"
 #include "StateSpaceType.h"
+#include "StaticKdTree.h"
+#include "TreeConfig.h"
 
 namespace base
 {
 	class Tree;
+	class TreeL2Adaptor;
 	typedef nanoflann::KDTreeSingleIndexDynamicAdaptor
-			<nanoflann::L2_Simple_Adaptor<float, base::Tree>, base::Tree /* dim */> KdTree;
+			<base::TreeL2Adaptor, base::Tree /* dim */> KdTree;
 
 	class Tree
 	{
@@ -23,6 +30,35 @@ namespace base
 		size_t tree_idx;
 		std::shared_ptr<std::vector<std::shared_ptr<base::State>>> states; 	// List of all nodes in the tree
         std::shared_ptr<base::KdTree> kd_tree;
+		
+		// When the tree becomes large enough, 'kd_tree' is replaced by a static Kd-tree built over the first nodes, 
+		// while the remaining (recently added) nodes are searched linearly, until the static Kd-tree is rebuilt in the background.
+		std::shared_ptr<base::StaticKdTree> static_kd_tree;
+		std::shared_future<std::shared_ptr<base::StaticKdTree>> static_kd_tree_next;
+		
+		// Contiguous (structure-of-arrays) storage, where all arrays are indexed by node index. 
+		// States from 'states' remain as a view to the nodes that is used by planners.
+		bool contiguous_storage;											// Whether the following arrays are used
+		size_t num_dimensions;												// Dimensionality of nodes (known after the first insertion)
+		std::vector<float> coords;											// Coordinates of all nodes packed one after another
+		std::vector<long> parents;											// Index of the parent of each node (-1 if there is no parent in the tree)
+
+		// Weighted metric, where each coordinate difference is multiplied by its weight (the same as in 'StateSpace::getNorm')
+		Eigen::VectorXf metric_weights;										// Weight of each dimension (empty: Euclidean metric)
+		std::vector<float> metric_weights_sqr;								// Squared weights used when computing squared distances
+		float approx_eps;													// Allowed relative error of 'getNearestState' (0: exact search)
+
+		// While the tree has at most 'linear_search_threshold' nodes, the Kd-tree is not built, and nodes are searched linearly. 
+		// Their (weighted) coordinates are stored dimension by dimension, so that distances to all nodes are computed using SIMD instructions.
+		size_t linear_search_threshold;
+		Eigen::Array<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> linear_coords;	// Row 'k' contains 'k'-th coordinate of all nodes
+		Eigen::Array<float, 1, Eigen::Dynamic> linear_dists_sqr;					// Squared distances from the query to all nodes
+
+		void addToStorage(const std::shared_ptr<base::State> q);
+		void addToIndex(size_t idx);
+		void updateStaticKdTree();
+		void takeStaticKdTree();
+		static void runQueries(size_t num_queries, const std::function<void(size_t, size_t)> &run_range, bool parallel);
 
 	public:
 		Tree() {}
@@ -36,27 +72,134 @@ namespace base
 		inline std::shared_ptr<base::State> getState(size_t idx) const { return states->at(idx); }
         inline std::shared_ptr<base::KdTree> getKdTree() const { return kd_tree; }
 		inline size_t getNumStates() const { return states->size(); }
+		inline bool getContiguousStorage() const { return contiguous_storage; }
+		inline const float *getCoordData(size_t idx) const 
+			{ return contiguous_storage ? coords.data() + idx * num_dimensions : (*states)[idx]->getCoord().data(); }
+		inline long getParentIdx(size_t idx) const { return parents[idx]; }
+		inline bool isInTree(const std::shared_ptr<base::State> q) const
+			{ return q != nullptr && q->getIdx() < states->size() && states->at(q->getIdx()) == q; }
+		inline const Eigen::VectorXf &getMetricWeights() const { return metric_weights; }
+		inline const float *getMetricWeightsSqr() const { return metric_weights_sqr.empty() ? nullptr : metric_weights_sqr.data(); }
+		inline float getMetricWeight(size_t dim) const { return metric_weights.size() == 0 ? 1 : metric_weights(dim); }
+		inline float getApproxEps() const { return approx_eps; }
 
 		inline void setTreeName(const std::string &tree_name_) { tree_name = tree_name_; }
 		inline void setTreeIdx(const size_t tree_idx_) { tree_idx = tree_idx_; }
 		inline void setStates(const std::shared_ptr<std::vector<std::shared_ptr<base::State>>> states_) { states = states_; }
 		inline void setState(const std::shared_ptr<base::State> state, size_t idx) { states->at(idx) = state; }
         inline void setKdTree(const std::shared_ptr<base::KdTree> kdtree_) { kd_tree = kdtree_; }
+		void setMetricWeights(const Eigen::VectorXf &metric_weights_);
+		inline void setApproxEps(float approx_eps_) { approx_eps = approx_eps_; }
 
 		void clearTree();
 		std::shared_ptr<base::State> getNearestState(const std::shared_ptr<base::State> q);
 		std::shared_ptr<base::State> getNearestState2(const std::shared_ptr<base::State> q);
+		std::vector<std::vector<std::shared_ptr<base::State>>> getKNearestStates
+			(const std::vector<std::shared_ptr<base::State>> &qs, size_t k, bool parallel = false) const;
+		std::vector<std::vector<std::shared_ptr<base::State>>> getStatesWithinRadius
+			(const std::vector<std::shared_ptr<base::State>> &qs, float r, bool parallel = false) const;
 		void upgradeTree(const std::shared_ptr<base::State> q_new, const std::shared_ptr<base::State> q_parent);
 		void upgradeTree(const std::shared_ptr<base::State> q_new, const std::shared_ptr<base::State> q_parent, 
 						 const std::shared_ptr<base::State> q_ref);
+		void refreshState(size_t idx);
+		void waitForRebuild();
+		std::vector<std::shared_ptr<base::State>> computePathToRoot(size_t idx) const;
 
 		template <class BBOX> 
         bool kdtree_get_bbox(BBOX& /* bb */) const { return false; }
 		inline size_t kdtree_get_point_count() const { return states->size(); }
-		inline float kdtree_get_pt(const size_t idx, const size_t dim) const { return states->at(idx)->getCoord(dim); }
+		inline float kdtree_get_pt(const size_t idx, const size_t dim) const { return getCoordData(idx)[dim]; }
 
 		friend std::ostream &operator<<(std::ostream &os, const Tree &tree);
+
+	private:
+		// Squared Euclidean distance between 'q' and the node 'idx'
+		inline float computeDistanceSqr(const float *q, size_t idx) const
+		{
+			const float *q_idx { getCoordData(idx) };
+			float d { 0 };
+			if (metric_weights_sqr.empty())
+			{
+				for (size_t k = 0; k < num_dimensions; k++)
+					d += (q_idx[k] - q[k]) * (q_idx[k] - q[k]);
+			}
+			else
+			{
+				for (size_t k = 0; k < num_dimensions; k++)
+					d += metric_weights_sqr[k] * (q_idx[k] - q[k]) * (q_idx[k] - q[k]);
+			}
+			return d;
+		}
+
+		template <class RESULTSET>
+		void findNeighbors(RESULTSET &result_set, const float *q, float eps = 0) const;
+	};
+
+	// Squared (weighted) Euclidean metric for 'KdTree'. Unlike 'nanoflann::L2_Simple_Adaptor', which fetches each coordinate 
+	// separately through 'kdtree_get_pt', it reads all coordinates of a node at once from the tree's buffer.
+	class TreeL2Adaptor
+	{
+	public:
+		typedef float ElementType;
+		typedef float DistanceType;
+		
+		TreeL2Adaptor(const base::Tree &tree_) : tree(tree_) {}
+
+		inline float evalMetric(const float *a, const size_t b_idx, size_t size) const
+		{
+			const float *b { tree.getCoordData(b_idx) };
+			const float *w_sqr { tree.getMetricWeightsSqr() };
+			float d { 0 };
+			if (w_sqr == nullptr)
+			{
+				for (size_t i = 0; i < size; i++)
+					d += (a[i] - b[i]) * (a[i] - b[i]);
+			}
+			else
+			{
+				for (size_t i = 0; i < size; i++)
+					d += w_sqr[i] * (a[i] - b[i]) * (a[i] - b[i]);
+			}
+			return d;
+		}
+
+		template <typename U, typename V>
+		inline float accum_dist(const U a, const V b, const size_t dim) const 
+		{
+			const float *w_sqr { tree.getMetricWeightsSqr() };
+			return (w_sqr == nullptr ? 1 : w_sqr[dim]) * (a - b) * (a - b);
+		}
+
+	private:
+		const base::Tree &tree;
 	};
+
+	// Add all nodes near 'q' to 'result_set', which is a nanoflann result set using squared distances.
+	// The answer is exact for 'eps' = 0, regardless of whether the dynamic Kd-tree, the static Kd-tree or linear search is used.
+	// Otherwise, Kd-trees may return nodes whose distance is up to (1 + 'eps') times larger than the true one.
+	template <class RESULTSET>
+	void Tree::findNeighbors(RESULTSET &result_set, const float *q, float eps) const
+	{
+		if (static_kd_tree != nullptr)
+		{
+			if (metric_weights.size() == 0)
+				static_kd_tree->findNeighbors(result_set, q, nanoflann::SearchParams(10, eps));
+			else	// The static Kd-tree contains weighted coordinates
+			{
+				Eigen::VectorXf q_weighted { Eigen::Map<const Eigen::VectorXf>(q, num_dimensions).cwiseProduct(metric_weights) };
+				static_kd_tree->findNeighbors(result_set, q_weighted.data(), nanoflann::SearchParams(10, eps));
+			}
+			for (size_t i = static_kd_tree->getNumStates(); i < states->size(); i++)
+				result_set.addPoint(computeDistanceSqr(q, i), i);
+		}
+		else if (kd_tree != nullptr)
+			kd_tree->findNeighbors(result_set, q, nanoflann::SearchParams(10, eps));
+		else
+		{
+			for (size_t i = 0; i < states->size(); i++)
+				result_set.addPoint(computeDistanceSqr(q, i), i);
+		}
+	}
 }
 
 #endif //RPMPL_TREE_H
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include <memory>
 #include <Eigen/Dense>
 #include <tuple>
+#include <algorithm>
 // #include <glog/log_severity.h>
 // #include <glog/logging.h>
 
@@ -16,15 +17,24 @@
 
 namespace base
 {
+	// Axis-aligned boxes packed in SoA layout, where each row is one of (x_min, y_min, z_min, x_max, y_max, z_max) of all boxes
+	typedef Eigen::Array<float, 6, Eigen::Dynamic, Eigen::RowMajor> BoxesSoA;
+
+	// Nearest points, where the first column is the robot's (capsule's) point, and the second column is the obstacle's point
+	typedef Eigen::Matrix<float, 3, 2> NearestPoints;
+
     class CollisionAndDistance
     {
     public:
         CollisionAndDistance() {}
 
 		static bool collisionCapsuleToBox(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, Eigen::VectorXf &obs);
-		static bool collisionCapsuleToRectangle(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, Eigen::VectorXf &obs, size_t coord);
+		static bool collisionCapsuleToBoxes(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, const BoxesSoA &boxes, size_t first = 0);
+		static bool collisionCapsuleToRectangle(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, const Eigen::VectorXf &obs, size_t coord);
 		static bool collisionLineSegToLineSeg(const Eigen::Vector3f &A, const Eigen::Vector3f &B, Eigen::Vector3f &C, Eigen::Vector3f &D);
-		static bool collisionCapsuleToSphere(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, Eigen::VectorXf &obs);
+		static bool collisionCapsuleToSphere(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, const Eigen::VectorXf &obs);
+		static bool collisionCapsuleToOrientedBox(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, 
+			const Eigen::Matrix3f &R, const Eigen::Vector3f &center, Eigen::VectorXf &obs);
 
         static std::tuple<float, std::shared_ptr<Eigen::MatrixXf>> distanceCapsuleToBox
 			(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, Eigen::VectorXf &obs);
@@ -35,6 +45,20 @@ namespace base
 		static std::tuple<float, std::shared_ptr<Eigen::MatrixXf>> distanceCapsuleToSphere
 			(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, Eigen::VectorXf &obs);
 
+		// Variants without heap allocations, where nearest points are stored into 'nearest_pts' (only if there is no collision)
+		static float distanceCapsuleToBox
+			(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, const Eigen::VectorXf &obs, NearestPoints &nearest_pts);
+		static float distanceCapsuleToBoxLowerBound
+			(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, const Eigen::VectorXf &obs, NearestPoints &plane_pts);
+		static float distanceLineSegToLineSeg
+			(const Eigen::Vector3f &A, const Eigen::Vector3f &B, const Eigen::Vector3f &C, const Eigen::Vector3f &D, NearestPoints &nearest_pts);
+		static float distanceLineSegToPoint
+			(const Eigen::Vector3f &A, const Eigen::Vector3f &B, const Eigen::Vector3f &C, NearestPoints &nearest_pts);
+		static float distanceCapsuleToSphere
+			(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, const Eigen::VectorXf &obs, NearestPoints &nearest_pts);
+		static float distanceCapsuleToOrientedBox(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, 
+			const Eigen::Matrix3f &R, const Eigen::Vector3f &center, const Eigen::VectorXf &obs, NearestPoints &nearest_pts);
+
     private:
 		static float checkCases(const Eigen::Vector3f &A, const Eigen::Vector3f &B, Eigen::Vector4f &rec, Eigen::Vector2f &point, 
                                 float obs_coord, size_t coord);
@@ -43,28 +67,28 @@ namespace base
         class CapsuleToBox
         {
         private:
-            std::shared_ptr<Eigen::MatrixXf> nearest_pts;
+            NearestPoints nearest_pts;
             Eigen::Vector3f A, B, P1, P2;
-            Eigen::MatrixXi projections;					// Determines whether projections on obs exist. First column is for point 'A', and second is for point 'B'
+            Eigen::Matrix<int, 6, 2> projections;					// Determines whether projections on obs exist. First column is for point 'A', and second is for point 'B'
             Eigen::Vector2f dist_AB_obs;					// Distances of 'A' and 'B' to 'obs' (if projections exist)
-            Eigen::MatrixXf AB;								// Contains points 'A' and 'B'
-            Eigen::VectorXf obs;
+            Eigen::Matrix<float, 3, 2> AB;					// Contains points 'A' and 'B'
+            const Eigen::VectorXf &obs;
             float d_c;
             float radius;
 
             void projectionLineSegOnSide(size_t min1, size_t min2, size_t min3, size_t max1, size_t max2, size_t max3);
             void checkEdges(Eigen::Vector3f &point, size_t k);
-            std::shared_ptr<Eigen::MatrixXf> getLineSegments(const Eigen::Vector2f &point, float min1, float min2, float max1, float max2, 
-                                                             float coord_value, size_t coord);
-            void distanceToMoreLineSegments(const Eigen::MatrixXf &line_segments);
+            size_t getLineSegments(const Eigen::Vector2f &point, float min1, float min2, float max1, float max2, 
+                                   float coord_value, size_t coord, Eigen::Matrix<float, 3, 4> &line_segments);
+            void distanceToMoreLineSegments(const Eigen::Ref<const Eigen::Matrix3Xf> &line_segments);
             void checkOtherCases();
 
         public:
-            CapsuleToBox(const Eigen::Vector3f &A_, const Eigen::Vector3f &B_, float radius_, Eigen::VectorXf &obs_);
+            CapsuleToBox(const Eigen::Vector3f &A_, const Eigen::Vector3f &B_, float radius_, const Eigen::VectorXf &obs_);
 
             void compute();
             float getDistance() { return d_c; }
-            std::shared_ptr<Eigen::MatrixXf> getNearestPoints() { return nearest_pts; }
+            const NearestPoints &getNearestPoints() { return nearest_pts; }
         };
     };
 }
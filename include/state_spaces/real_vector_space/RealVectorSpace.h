@@ -12,6 +12,8 @@
 #include "RealVectorSpaceConfig.h"
 #include "xArm6.h"
 
+#include <queue>
+
 namespace base
 {
 	class RealVectorSpace : public base::StateSpace,
@@ -42,12 +44,65 @@ namespace base
 
 		bool isValid(const std::shared_ptr<base::State> q1, const std::shared_ptr<base::State> q2) override;
 		virtual bool isValid(const std::shared_ptr<base::State> q) override;
+		virtual bool isValid(const Eigen::VectorXf &q_coord);
 		virtual float computeDistance(const std::shared_ptr<base::State> q, bool compute_again) override;
+		virtual bool isDistanceGreater(const std::shared_ptr<base::State> q, float d_threshold) override;
 		float computeDistanceUnderestimation(const std::shared_ptr<base::State> q, 
 			const std::shared_ptr<std::vector<Eigen::MatrixXf>> nearest_points) override;
 			
+		Eigen::VectorXf computeMetricWeights();
+		static std::vector<size_t> computeEdgeCheckOrder(size_t num_checks, base::EdgeCheckOrder order);
+			
 		friend std::ostream &operator<<(std::ostream &os, const RealVectorSpace &space);
 		
+	protected:
+		bool isValidSkeleton(const Eigen::MatrixXf &skeleton);
+		virtual bool isValidBatch(const robots::BatchSoA &q_coords, size_t num_configs);
+		void updateObstacles();
+		void buildObstacleGrid();
+		bool collisionCapsuleToGridBoxes(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius);
+		float computeDistanceThresholded(const std::shared_ptr<base::State> q, float d_threshold);
+		float computeCertifiedFraction(const std::shared_ptr<base::State> q, const std::shared_ptr<base::State> q_e, float d_c);
+
+		Eigen::VectorXf q_coord_scratch;		// Scratch buffers for edge validity checking, which are reused 
+		Eigen::MatrixXf skeleton_scratch;		// for all interpolated configurations to avoid heap allocations
+		robots::BatchSoA q_coords_batch;
+		robots::BatchSoA skeletons_batch;
+
+		// Snapshot of obstacles from 'env', which is updated only when the environment or its version is changed
+		std::shared_ptr<env::Environment> obstacles_env;	// Kept alive, so another environment cannot get the same address
+		size_t obstacles_version;
+		std::vector<fcl::NODE_TYPE> obstacle_types;
+		std::vector<bool> obstacle_is_ground;
+		Eigen::Matrix<float, 6, Eigen::Dynamic> obstacle_bounds;	// AABB (x_min, y_min, z_min, x_max, y_max, z_max) of each obstacle
+		Eigen::VectorXf obstacle_min_dist_tols;
+		std::vector<bool> obstacle_is_oriented;	// Whether a box obstacle is rotated, so its AABB is only its bounding volume
+		std::vector<size_t> obstacle_packed_idx;	// Column of each sphere in 'spheres', or of each oriented box in 'oriented_boxes'
+		base::BoxesSoA boxes;					// Axis-aligned box obstacles packed for 'collisionCapsuleToBoxes', where ground boxes come first
+		size_t num_ground_boxes;
+		std::vector<size_t> sphere_indices;		// Indices of sphere obstacles in 'env'
+		Eigen::Matrix<float, 4, Eigen::Dynamic> spheres;	// Center and radius (x_c, y_c, z_c, r) of each sphere from 'sphere_indices'
+		std::vector<size_t> oriented_box_indices;			// Indices of oriented box obstacles in 'env'
+		Eigen::Matrix<float, 6, Eigen::Dynamic> oriented_boxes;	// Each oriented box in its own frame (-h_x, -h_y, -h_z, h_x, h_y, h_z)
+		std::vector<Eigen::Matrix3f> oriented_box_rotations;
+		Eigen::Matrix3Xf oriented_box_centers;
+		size_t broad_phase_threshold;
+
+		// Uniform grid over non-ground boxes for broad-phase culling, which is built together with the snapshot.
+		// It is used only for collision checking, while the distance computation visits all obstacles, 
+		// since nearest points are stored for each obstacle.
+		bool use_grid;
+		Eigen::Array3f grid_min;
+		Eigen::Array3f grid_cell_size;
+		Eigen::Array3i grid_dims;
+		std::vector<size_t> grid_cell_starts;	// Boxes in the cell c are 'grid_boxes[grid_cell_starts[c]]', ..., 'grid_boxes[grid_cell_starts[c+1]-1]'
+		std::vector<size_t> grid_boxes;			// Column indices of boxes in 'boxes'
+		std::vector<size_t> grid_stamps;		// The last query in which each box is checked
+		size_t grid_query;
+		Eigen::VectorXf obs_scratch;
+		Eigen::VectorXf sphere_scratch;
+		std::vector<size_t> edge_check_order;	// Indices of interpolated configurations in the order they are checked
+		base::EdgeCheckOrder edge_check_order_type;
 	};
 }
 
@@ -5,6 +5,8 @@
 #ifndef RPMPL_REALVECTORSPACEFCL_H
 #define RPMPL_REALVECTORSPACEFCL_H
 
+#include <unordered_map>
+
 #include "RealVectorSpace.h"
 #include "RealVectorSpaceConfig.h"
 #include "xArm6.h"
@@ -25,7 +27,40 @@ namespace base
 		std::shared_ptr<fcl::BroadPhaseCollisionManagerf> getCollisionManagerEnv() const { return collision_manager_env; }
 		
 		bool isValid(const std::shared_ptr<base::State> q) override;
+		bool isValid(const Eigen::VectorXf &q_coord) override;
 		float computeDistance(const std::shared_ptr<base::State> q, bool compute_again) override;
+		bool isDistanceGreater(const std::shared_ptr<base::State> q, float d_threshold) override;
+
+	protected:
+		bool isValidBatch(const robots::BatchSoA &q_coords, size_t num_configs) override;
+
+	private:
+		// Data passed to FCL callbacks, which are called for each pair of robot's link and obstacle with overlapping AABBs
+		struct CollisionData
+		{
+			base::RealVectorSpaceFCL *ss;
+			bool is_collision;
+		};
+
+		struct DistanceData
+		{
+			base::RealVectorSpaceFCL *ss;
+			fcl::DistanceRequest<float> request;
+			fcl::DistanceResult<float> result;
+			std::vector<float> d_c_profile;
+			std::shared_ptr<std::vector<Eigen::MatrixXf>> nearest_points;
+		};
+
+		void updateCollisionManagers(const std::shared_ptr<base::State> q);
+		bool getPairIndices(fcl::CollisionObjectf *o1, fcl::CollisionObjectf *o2, fcl::CollisionObjectf *&link, 
+							fcl::CollisionObjectf *&obs, size_t &link_idx, size_t &obs_idx) const;
+		static bool collisionCallback(fcl::CollisionObjectf *o1, fcl::CollisionObjectf *o2, void *data);
+		static bool distanceCallback(fcl::CollisionObjectf *o1, fcl::CollisionObjectf *o2, void *data, float &dist);
+
+		std::unordered_map<const fcl::CollisionObjectf*, size_t> link_indices;		// Index of each robot's link registered in 'collision_manager_robot'
+		std::unordered_map<const fcl::CollisionObjectf*, size_t> obstacle_indices;	// Index in 'env' of each obstacle registered in 'collision_manager_env'
+		std::shared_ptr<env::Environment> env_manager_env;	// Environment for which 'collision_manager_env' is built (kept alive with its objects)
+		size_t env_manager_version;		// Version of 'env_manager_env' for which 'collision_manager_env' is built
 	};
 }
 
@@ -0,0 +1,88 @@
+#ifndef RPMPL_REALVECTORSPACEN_H
+#define RPMPL_REALVECTORSPACEN_H
+
+#include "RealVectorSpace.h"
+#include "RealVectorSpaceFCL.h"
+
+namespace base
+{
+	// Real vector space whose dimensionality 'N' is known at compile time, where 'Space' is 'RealVectorSpace' or 'RealVectorSpaceFCL'.
+	// Coordinates of states are still stored as 'Eigen::VectorXf', but they are accessed through fixed-size maps, 
+	// so norms, edge interpolation and sampling use stack storage and unrolled (vectorized) Eigen expressions.
+	template <size_t N, class Space = base::RealVectorSpace>
+	class RealVectorSpaceN : public Space
+	{
+	public:
+		typedef Eigen::Matrix<float, N, 1> Coord;
+		typedef Eigen::Map<const Coord> CoordMap;
+
+		RealVectorSpaceN(const std::shared_ptr<robots::AbstractRobot> robot_, const std::shared_ptr<env::Environment> env_) : 
+			Space(N, robot_, env_) {}
+		~RealVectorSpaceN() {}
+
+		std::shared_ptr<base::State> getRandomState(const std::shared_ptr<base::State> q_center) override;
+		float getNorm(const std::shared_ptr<base::State> q1, const std::shared_ptr<base::State> q2) override;
+		bool isEqual(const Eigen::VectorXf &q1_coord, const Eigen::VectorXf &q2_coord) override;
+		std::shared_ptr<base::State> interpolateEdge
+			(const std::shared_ptr<base::State> q1, const std::shared_ptr<base::State> q2, float step, float dist) override;
+	};
+
+	// Get a random state with uniform distribution, which is limited by robot joint limits
+	// If 'q_center' is passed, it is added to the random state 
+	template <size_t N, class Space>
+	std::shared_ptr<base::State> RealVectorSpaceN<N, Space>::getRandomState(const std::shared_ptr<base::State> q_center)
+	{
+		Coord q_rand_coord { Coord::Random() };
+		const std::vector<std::pair<float, float>> &limits { this->robot->getLimits() };
+
+		for (size_t i = 0; i < N; i++)
+			q_rand_coord(i) = ((limits[i].second - limits[i].first) * q_rand_coord(i) + limits[i].first + limits[i].second) / 2;
+
+		if (q_center != nullptr)
+			q_rand_coord += CoordMap(q_center->getCoord().data());
+
+		return this->getNewState(q_rand_coord);
+	}
+
+	// Get (weighted) Euclidean distance between two states (get norm of the vector 'q2 - q1')
+	template <size_t N, class Space>
+	float RealVectorSpaceN<N, Space>::getNorm(const std::shared_ptr<base::State> q1, const std::shared_ptr<base::State> q2)
+	{
+		const Coord q_diff { CoordMap(q1->getCoord().data()) - CoordMap(q2->getCoord().data()) };
+		if (this->metric_weights.size() == 0)
+			return q_diff.norm();
+		
+		return q_diff.cwiseProduct(CoordMap(this->metric_weights.data())).norm();
+	}
+
+	// Check if two vectors are equal (using the same metric as 'getNorm')
+	template <size_t N, class Space>
+	bool RealVectorSpaceN<N, Space>::isEqual(const Eigen::VectorXf &q1_coord, const Eigen::VectorXf &q2_coord)
+	{
+		const Coord q_diff { CoordMap(q1_coord.data()) - CoordMap(q2_coord.data()) };
+		if (this->metric_weights.size() == 0)
+			return q_diff.norm() < RealVectorSpaceConfig::EQUALITY_THRESHOLD;
+		
+		return q_diff.cwiseProduct(CoordMap(this->metric_weights.data())).norm() < RealVectorSpaceConfig::EQUALITY_THRESHOLD;
+	}
+
+	// Interpolate edge from 'q1' to 'q2' for step 'step'
+	// 'dist' (optional parameter) is the distance between 'q1' and 'q2'
+	// Return a new state
+	template <size_t N, class Space>
+	std::shared_ptr<base::State> RealVectorSpaceN<N, Space>::interpolateEdge
+		(const std::shared_ptr<base::State> q1, const std::shared_ptr<base::State> q2, float step, float dist)
+	{
+		if (dist < 0) 	// 'dist' = -1 is default value
+			dist = getNorm(q1, q2);
+		
+		if (dist <= 0)
+			return this->getNewState(q2->getCoord());
+
+		const CoordMap q1_coord(q1->getCoord().data());
+		const Coord q_new_coord { q1_coord + (CoordMap(q2->getCoord().data()) - q1_coord) * (step / dist) };
+		return this->getNewState(q_new_coord);
+	}
+}
+
+#endif //RPMPL_REALVECTORSPACEN_H
\ No newline at end of file
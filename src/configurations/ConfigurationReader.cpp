@@ -9,6 +9,7 @@ void ConfigurationReader::initConfiguration(const std::string &root_path)
     YAML::Node RGBMTStarConfigRoot          { YAML::LoadFile(root_path + "/data/configurations/configuration_rgbmtstar.yaml") };
     YAML::Node DRGBTConfigRoot              { YAML::LoadFile(root_path + "/data/configurations/configuration_drgbt.yaml") };
     YAML::Node SplinesConfigRoot            { YAML::LoadFile(root_path + "/data/configurations/configuration_splines.yaml") };
+    YAML::Node TreeConfigRoot               { YAML::LoadFile(root_path + "/data/configurations/configuration_tree.yaml") };
 
     // RealVectorSpaceConfigRoot
     if (RealVectorSpaceConfigRoot["NUM_INTERPOLATION_VALIDITY_CHECKS"].IsDefined())
@@ -21,6 +22,41 @@ void ConfigurationReader::initConfiguration(const std::string &root_path)
     else
         LOG(INFO) << "RealVectorSpaceConfig::EQUALITY_THRESHOLD is not defined! Using default value of " << RealVectorSpaceConfig::EQUALITY_THRESHOLD;
 
+    if (RealVectorSpaceConfigRoot["EDGE_CHECK_ORDER"].IsDefined())
+        RealVectorSpaceConfig::EDGE_CHECK_ORDER = base::edge_check_order_map[RealVectorSpaceConfigRoot["EDGE_CHECK_ORDER"].as<std::string>()];
+    else
+        LOG(INFO) << "RealVectorSpaceConfig::EDGE_CHECK_ORDER is not defined! Using default value of " << RealVectorSpaceConfig::EDGE_CHECK_ORDER;
+
+    if (RealVectorSpaceConfigRoot["CERTIFIED_EDGE_VALIDATION"].IsDefined())
+        RealVectorSpaceConfig::CERTIFIED_EDGE_VALIDATION = RealVectorSpaceConfigRoot["CERTIFIED_EDGE_VALIDATION"].as<bool>();
+    else
+        LOG(INFO) << "RealVectorSpaceConfig::CERTIFIED_EDGE_VALIDATION is not defined! Using default value of " << RealVectorSpaceConfig::CERTIFIED_EDGE_VALIDATION;
+
+    if (RealVectorSpaceConfigRoot["BROAD_PHASE_THRESHOLD"].IsDefined())
+        RealVectorSpaceConfig::BROAD_PHASE_THRESHOLD = RealVectorSpaceConfigRoot["BROAD_PHASE_THRESHOLD"].as<size_t>();
+    else
+        LOG(INFO) << "RealVectorSpaceConfig::BROAD_PHASE_THRESHOLD is not defined! Using default value of " << RealVectorSpaceConfig::BROAD_PHASE_THRESHOLD;
+
+    if (RealVectorSpaceConfigRoot["USE_DISTANCE_LOWER_BOUND"].IsDefined())
+        RealVectorSpaceConfig::USE_DISTANCE_LOWER_BOUND = RealVectorSpaceConfigRoot["USE_DISTANCE_LOWER_BOUND"].as<bool>();
+    else
+        LOG(INFO) << "RealVectorSpaceConfig::USE_DISTANCE_LOWER_BOUND is not defined! Using default value of " << RealVectorSpaceConfig::USE_DISTANCE_LOWER_BOUND;
+
+    if (RealVectorSpaceConfigRoot["WEIGHTED_METRIC"].IsDefined())
+        RealVectorSpaceConfig::WEIGHTED_METRIC = RealVectorSpaceConfigRoot["WEIGHTED_METRIC"].as<bool>();
+    else
+        LOG(INFO) << "RealVectorSpaceConfig::WEIGHTED_METRIC is not defined! Using default value of " << RealVectorSpaceConfig::WEIGHTED_METRIC;
+
+    if (RealVectorSpaceConfigRoot["STATE_POOL_CHUNK_SIZE"].IsDefined())
+        RealVectorSpaceConfig::STATE_POOL_CHUNK_SIZE = RealVectorSpaceConfigRoot["STATE_POOL_CHUNK_SIZE"].as<size_t>();
+    else
+        LOG(INFO) << "RealVectorSpaceConfig::STATE_POOL_CHUNK_SIZE is not defined! Using default value of " << RealVectorSpaceConfig::STATE_POOL_CHUNK_SIZE;
+
+    if (RealVectorSpaceConfigRoot["KINEMATICS_CACHE_SIZE"].IsDefined())
+        RealVectorSpaceConfig::KINEMATICS_CACHE_SIZE = RealVectorSpaceConfigRoot["KINEMATICS_CACHE_SIZE"].as<size_t>();
+    else
+        LOG(INFO) << "RealVectorSpaceConfig::KINEMATICS_CACHE_SIZE is not defined! Using default value of " << RealVectorSpaceConfig::KINEMATICS_CACHE_SIZE;
+
     // RRTConnectConfigRoot
     if (RRTConnectConfigRoot["MAX_NUM_ITER"].IsDefined())
         RRTConnectConfig::MAX_NUM_ITER = RRTConnectConfigRoot["MAX_NUM_ITER"].as<size_t>();
@@ -47,6 +83,11 @@ void ConfigurationReader::initConfiguration(const std::string &root_path)
     else
         LOG(INFO) << "RRTConnectConfig::EPS_STEP is not defined! Using default value of " << RRTConnectConfig::EPS_STEP;
 
+    if (RRTConnectConfigRoot["NN_APPROX_EPS"].IsDefined())
+        RRTConnectConfig::NN_APPROX_EPS = RRTConnectConfigRoot["NN_APPROX_EPS"].as<float>();
+    else
+        LOG(INFO) << "RRTConnectConfig::NN_APPROX_EPS is not defined! Using default value of " << RRTConnectConfig::NN_APPROX_EPS;
+
     // RBTConnectConfigRoot
     if (RBTConnectConfigRoot["MAX_NUM_ITER"].IsDefined())
         RBTConnectConfig::MAX_NUM_ITER = RBTConnectConfigRoot["MAX_NUM_ITER"].as<size_t>();
@@ -108,6 +149,11 @@ void ConfigurationReader::initConfiguration(const std::string &root_path)
         RGBTConnectConfig::NUM_LAYERS = RGBTConnectConfigRoot["NUM_LAYERS"].as<size_t>();
     else
         LOG(INFO) << "RGBTConnectConfig::NUM_LAYERS is not defined! Using default value of " << RGBTConnectConfig::NUM_LAYERS;
+
+    if (RGBTConnectConfigRoot["NN_APPROX_EPS"].IsDefined())
+        RGBTConnectConfig::NN_APPROX_EPS = RGBTConnectConfigRoot["NN_APPROX_EPS"].as<float>();
+    else
+        LOG(INFO) << "RGBTConnectConfig::NN_APPROX_EPS is not defined! Using default value of " << RGBTConnectConfig::NN_APPROX_EPS;
     
     // RGBMTStarConfigRoot
     if (RGBMTStarConfigRoot["MAX_NUM_ITER"].IsDefined())
@@ -227,5 +273,26 @@ void ConfigurationReader::initConfiguration(const std::string &root_path)
     else
         LOG(INFO) << "SplinesConfig::FINAL_VELOCITY_STEP is not defined! Using default value of " << SplinesConfig::FINAL_VELOCITY_STEP;
     
+    // TreeConfigRoot
+    if (TreeConfigRoot["CONTIGUOUS_STORAGE"].IsDefined())
+        TreeConfig::CONTIGUOUS_STORAGE = TreeConfigRoot["CONTIGUOUS_STORAGE"].as<bool>();
+    else
+        LOG(INFO) << "TreeConfig::CONTIGUOUS_STORAGE is not defined! Using default value of " << TreeConfig::CONTIGUOUS_STORAGE;
+
+    if (TreeConfigRoot["STATIC_KD_TREE_THRESHOLD"].IsDefined())
+        TreeConfig::STATIC_KD_TREE_THRESHOLD = TreeConfigRoot["STATIC_KD_TREE_THRESHOLD"].as<size_t>();
+    else
+        LOG(INFO) << "TreeConfig::STATIC_KD_TREE_THRESHOLD is not defined! Using default value of " << TreeConfig::STATIC_KD_TREE_THRESHOLD;
+
+    if (TreeConfigRoot["KD_TREE_BUFFER_SIZE"].IsDefined())
+        TreeConfig::KD_TREE_BUFFER_SIZE = TreeConfigRoot["KD_TREE_BUFFER_SIZE"].as<size_t>();
+    else
+        LOG(INFO) << "TreeConfig::KD_TREE_BUFFER_SIZE is not defined! Using default value of " << TreeConfig::KD_TREE_BUFFER_SIZE;
+
+    if (TreeConfigRoot["LINEAR_SEARCH_THRESHOLD"].IsDefined())
+        TreeConfig::LINEAR_SEARCH_THRESHOLD = TreeConfigRoot["LINEAR_SEARCH_THRESHOLD"].as<size_t>();
+    else
+        LOG(INFO) << "TreeConfig::LINEAR_SEARCH_THRESHOLD is not defined! Using default value of " << TreeConfig::LINEAR_SEARCH_THRESHOLD;
+    
     LOG(INFO) << "Configuration parameters read successfully!";
 }
@@ -3,4 +3,5 @@
 size_t RGBTConnectConfig::MAX_NUM_ITER      = 1e9;
 size_t RGBTConnectConfig::MAX_NUM_STATES    = 1e9;
 float RGBTConnectConfig::MAX_PLANNING_TIME  = 60;
-size_t RGBTConnectConfig::NUM_LAYERS        = 5;
\ No newline at end of file
+size_t RGBTConnectConfig::NUM_LAYERS        = 5;
+float RGBTConnectConfig::NN_APPROX_EPS       = 0;
\ No newline at end of file
@@ -4,4 +4,5 @@ size_t RRTConnectConfig::MAX_NUM_ITER           = 1e9;
 size_t RRTConnectConfig::MAX_NUM_STATES         = 1e9;
 float RRTConnectConfig::MAX_PLANNING_TIME       = 60;
 size_t RRTConnectConfig::MAX_EXTENSION_STEPS    = 50;
-float RRTConnectConfig::EPS_STEP                = 0.1;
\ No newline at end of file
+float RRTConnectConfig::EPS_STEP                = 0.1;
+float RRTConnectConfig::NN_APPROX_EPS           = 0;
\ No newline at end of file
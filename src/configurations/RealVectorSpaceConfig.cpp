@@ -1,4 +1,11 @@
 #include "RealVectorSpaceConfig.h"
 
 size_t RealVectorSpaceConfig::NUM_INTERPOLATION_VALIDITY_CHECKS = 15;
-float RealVectorSpaceConfig::EQUALITY_THRESHOLD                 = 1e-6;
\ No newline at end of file
+float RealVectorSpaceConfig::EQUALITY_THRESHOLD                 = 1e-6;
+base::EdgeCheckOrder RealVectorSpaceConfig::EDGE_CHECK_ORDER    = base::EdgeCheckOrder::Backward;
+bool RealVectorSpaceConfig::CERTIFIED_EDGE_VALIDATION           = false;
+size_t RealVectorSpaceConfig::BROAD_PHASE_THRESHOLD             = 0;
+bool RealVectorSpaceConfig::USE_DISTANCE_LOWER_BOUND            = false;
+bool RealVectorSpaceConfig::WEIGHTED_METRIC                     = false;
+size_t RealVectorSpaceConfig::STATE_POOL_CHUNK_SIZE             = 0;
+size_t RealVectorSpaceConfig::KINEMATICS_CACHE_SIZE             = 0;
\ No newline at end of file
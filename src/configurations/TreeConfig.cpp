@@ -0,0 +1,6 @@
+#include "TreeConfig.h"
+
+bool TreeConfig::CONTIGUOUS_STORAGE             = false;
+size_t TreeConfig::STATIC_KD_TREE_THRESHOLD     = 0;
+size_t TreeConfig::KD_TREE_BUFFER_SIZE          = 1000;
+size_t TreeConfig::LINEAR_SEARCH_THRESHOLD      = 0;
\ No newline at end of file
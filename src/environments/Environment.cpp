@@ -1,19 +1,23 @@
 #include "Environment.h"
 
+// Objects of 'env' are copied, so changing them in one environment does not affect the other one
 env::Environment::Environment(const std::shared_ptr<env::Environment> env)
 {
-    objects = env->getObjects();
     WS_center = env->getWSCenter();
     WS_radius = env->getWSRadius();
     base_radius = env->getBaseRadius();
     robot_max_vel = env->getRobotMaxVel();
     ground_included = env->getGroundIncluded();
+    version = 0;
+    for (const std::shared_ptr<env::Object> &object : env->getObjects())
+        addObject(object->clone(), object->getVelocity(), object->getAcceleration());
 }
 
 env::Environment::Environment(const std::string &config_file_path, const std::string &root_path)
 {
     YAML::Node node { YAML::LoadFile(root_path + config_file_path) };
     size_t num_added { 0 };
+    version = 0;
 
     try
     {
@@ -50,11 +54,28 @@ env::Environment::Environment(const std::string &config_file_path, const std::st
             }
             else if (obstacle["sphere"].IsDefined())
             {
-                // TODO
+                std::string label = "";
+                if (obstacle["sphere"]["label"].IsDefined())
+                    label = obstacle["sphere"]["label"].as<std::string>();
+
+                if (label == "ground" && node["robot"]["ground_included"].as<size_t>() == 0)
+                    continue;
+
+                YAML::Node p = obstacle["sphere"]["pos"];
+                YAML::Node min_dist_tol = obstacle["sphere"]["min_dist_tol"];
+
+                float radius = obstacle["sphere"]["radius"].as<float>();
+                fcl::Vector3f pos(p[0].as<float>(), p[1].as<float>(), p[2].as<float>());
+
+                object = std::make_shared<env::Sphere>(radius, pos, label);
+
+                if (min_dist_tol.IsDefined())
+                    object->setMinDistTol(min_dist_tol.as<float>());
             }
             else
                 throw std::domain_error("Object type is wrong! ");
 
+            object->env_version = &version;
             objects.emplace_back(object);
             std::cout << "Added " << num_added++ << ". " << object;
         }
@@ -85,21 +106,26 @@ env::Environment::Environment(const std::string &config_file_path, const std::st
 
 env::Environment::~Environment()
 {
-    objects.clear();
+    removeAllObjects();
 }
 
+// Add 'object', which then belongs only to this environment, so its changes increase the version of this environment
 void env::Environment::addObject(const std::shared_ptr<env::Object> object, const fcl::Vector3f &velocity, 
                                  const fcl::Vector3f &acceleration) 
 {
     object->setVelocity(velocity);
     object->setAcceleration(acceleration);
+    object->env_version = &version;
     objects.emplace_back(object);
+    version++;
 }
 
 // Remove object at 'idx' position
 void env::Environment::removeObject(size_t idx)
 {
+    objects[idx]->env_version = nullptr;
     objects.erase(objects.begin() + idx);
+    version++;
 }
 
 // Remove objects from 'start_idx'-th object to 'end_idx'-th object
@@ -110,7 +136,11 @@ void env::Environment::removeObjects(int start_idx, int end_idx)
         end_idx = objects.size() - 1;
     
     for (int idx = end_idx; idx >= start_idx; idx--)
+    {
+        objects[idx]->env_version = nullptr;
         objects.erase(objects.begin() + idx);
+    }
+    version++;
 }
 
 // Remove objects with label 'label' if 'with_label' is true (default)
@@ -122,7 +152,10 @@ void env::Environment::removeObjects(const std::string &label, bool with_label)
         for (int idx = objects.size()-1; idx >= 0; idx--)
         {
             if (objects[idx]->getLabel() == label)
+            {
+                objects[idx]->env_version = nullptr;
                 objects.erase(objects.begin() + idx);
+            }
         }
     }
     else
@@ -130,15 +163,23 @@ void env::Environment::removeObjects(const std::string &label, bool with_label)
         for (int idx = objects.size()-1; idx >= 0; idx--)
         {
             if (objects[idx]->getLabel() != label)
+            {
+                objects[idx]->env_version = nullptr;
                 objects.erase(objects.begin() + idx);
+            }
         }
-    }        
+    }
+    version++;
 }
 
 // Remove all objects from the environment
 void env::Environment::removeAllObjects()
 {
+    for (const std::shared_ptr<env::Object> &object : objects)
+        object->env_version = nullptr;
+
     objects.clear();
+    version++;
 }
 
 // Check whether an object position 'pos' is valid when the object moves at 'vel' velocity
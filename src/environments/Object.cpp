@@ -1,5 +1,19 @@
 #include "Object.h"
 
+// Copy all data of 'object', where the copy gets its own collision object, and does not belong to any environment
+env::Object::Object(const env::Object &object)
+{
+    label = object.label;
+    coll_object = std::make_shared<fcl::CollisionObject<float>>(*object.coll_object);
+    position = object.position;
+    velocity = object.velocity;
+    acceleration = object.acceleration;
+    max_vel = object.max_vel;
+    max_acc = object.max_acc;
+    min_dist_tol = object.min_dist_tol;
+    env_version = nullptr;
+}
+
 env::Object::~Object() {}
 
 namespace env 
@@ -23,4 +37,5 @@ void env::Object::setPosition(const fcl::Vector3f &position_)
     position = position_;
     coll_object->setTranslation(position);
     coll_object->computeAABB();
+    updateVersion();
 }
\ No newline at end of file
@@ -0,0 +1,16 @@
+#include "Sphere.h"
+
+env::Sphere::Sphere(float radius_, const fcl::Vector3f &pos, const std::string &label_)
+{
+    std::shared_ptr<fcl::CollisionGeometry<float>> fcl_sphere { std::make_shared<fcl::Sphere<float>>(radius_) };
+    coll_object = std::make_shared<fcl::CollisionObject<float>>(fcl_sphere, fcl::Matrix3f::Identity(), pos);
+    coll_object->computeAABB();
+    position = pos;
+    velocity = fcl::Vector3f::Zero();
+    acceleration = fcl::Vector3f::Zero();
+    max_vel = 0;
+    max_acc = 0;
+    min_dist_tol = INFINITY;
+    label = label_;
+    radius = radius_;
+}
@@ -7,6 +7,8 @@ planning::AbstractPlanner::AbstractPlanner(std::shared_ptr<base::StateSpace> ss_
     q_start = nullptr;
     q_goal = nullptr;
     planner_info = std::make_shared<PlannerInfo>();
+    initStatePool();
+    initKinematicsCache();
 }
 
 planning::AbstractPlanner::AbstractPlanner(const std::shared_ptr<base::StateSpace> ss_, const std::shared_ptr<base::State> q_start_, 
@@ -17,9 +19,57 @@ planning::AbstractPlanner::AbstractPlanner(const std::shared_ptr<base::StateSpac
     q_start = q_start_;
     q_goal = q_goal_;
     planner_info = std::make_shared<PlannerInfo>();
+    initStatePool();
+    initKinematicsCache();
 }
 
-planning::AbstractPlanner::~AbstractPlanner() {}
+planning::AbstractPlanner::~AbstractPlanner() 
+{
+    // States allocated from the pool remain valid, and the pool is released after all of them are destroyed
+    if (state_pool != nullptr && ss->getStatePool() == state_pool)
+        ss->setStatePool(nullptr);
+    
+    // Quantities that remain in states are not tracked anymore
+    if (kinematics_cache != nullptr && ss->robot->getKinematicsCache() == kinematics_cache)
+        ss->robot->setKinematicsCache(nullptr);
+}
+
+// Get the planner info, where the counters of the kinematics cache used by the planner are updated.
+std::shared_ptr<PlannerInfo> planning::AbstractPlanner::getPlannerInfo() const
+{
+    if (kinematics_cache != nullptr)
+    {
+        planner_info->setNumKinematicsCacheHits(kinematics_cache->getNumHits());
+        planner_info->setNumKinematicsCacheMisses(kinematics_cache->getNumMisses());
+    }
+    return planner_info;
+}
+
+// Create a memory pool for all states that are created by the state space while the planner exists.
+// If the state space already uses a pool (e.g., of another planner that uses this one), the same pool is used.
+void planning::AbstractPlanner::initStatePool()
+{
+    state_pool = nullptr;
+    if (RealVectorSpaceConfig::STATE_POOL_CHUNK_SIZE == 0 || ss == nullptr || ss->getStatePool() != nullptr)
+        return;
+
+    state_pool = std::make_shared<base::StatePool>(RealVectorSpaceConfig::STATE_POOL_CHUNK_SIZE);
+    ss->setStatePool(state_pool);
+}
+
+// Create a cache which bounds the memory of frames, skeletons and enclosing radii kept in states while the planner exists.
+// If the robot already uses a cache (e.g., of another planner that uses this one), the same cache is used, 
+// but its counters are reported only by the planner that owns it.
+void planning::AbstractPlanner::initKinematicsCache()
+{
+    kinematics_cache = nullptr;
+    if (RealVectorSpaceConfig::KINEMATICS_CACHE_SIZE == 0 || ss == nullptr || ss->robot == nullptr || 
+        ss->robot->getKinematicsCache() != nullptr)
+        return;
+
+    kinematics_cache = std::make_shared<base::KinematicsCache>(RealVectorSpaceConfig::KINEMATICS_CACHE_SIZE * 1024 * 1024);
+    ss->robot->setKinematicsCache(kinematics_cache);
+}
 
 /// @brief Get elapsed time from 'time_init' to now.
 /// @param time_init Time point from which measuring time starts.
@@ -10,6 +10,8 @@ PlannerInfo::PlannerInfo()
 	planning_time = 0;
 	num_collision_queries = 0;
 	num_distance_queries = 0;
+	num_kinematics_cache_hits = 0;
+	num_kinematics_cache_misses = 0;
 	num_states = 0;
 	num_iterations = 0;
 	success_state = false;
@@ -57,6 +59,8 @@ void PlannerInfo::clearPlannerInfo()
 	planning_time = 0;
 	num_collision_queries = 0;
 	num_distance_queries = 0;
+	num_kinematics_cache_hits = 0;
+	num_kinematics_cache_misses = 0;
 	num_states = 0;
 	num_iterations = 0;
 }
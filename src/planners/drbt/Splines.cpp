@@ -121,12 +121,13 @@ bool planning::drbt::Splines::computeSafe(Eigen::VectorXf &current_pos, Eigen::V
     Eigen::VectorXf q_final_max { q_target->getCoord() };
     Eigen::VectorXf q_final { q_target->getCoord() };
 
+    std::shared_ptr<Eigen::MatrixXf> skeleton_current { ss->robot->computeSkeleton(q_current) };     // Kept, since the kinematics cache may release it
     auto computeRho = [&](Eigen::VectorXf q_coord) -> float
     {
         float rho { 0 };
         std::shared_ptr<Eigen::MatrixXf> skeleton { ss->robot->computeSkeleton(ss->getNewState(q_coord)) };
         for (size_t k = 1; k <= ss->robot->getNumLinks(); k++)
-            rho = std::max(rho, (q_current->getSkeleton()->col(k) - skeleton->col(k)).norm());
+            rho = std::max(rho, (skeleton_current->col(k) - skeleton->col(k)).norm());
 
         return rho;
     };
@@ -236,6 +237,7 @@ bool planning::drbt::Splines::checkCollision(std::shared_ptr<base::State> q_init
     float t_init { 0 };
     std::shared_ptr<base::State> q_final { nullptr };
 	Eigen::VectorXf delta_q {};
+    std::shared_ptr<Eigen::MatrixXf> R_init { ss->robot->computeEnclosingRadii(q_init) };
 
     for (float t = delta_t; t <= spline_next->getTimeFinal() + RealVectorSpaceConfig::EQUALITY_THRESHOLD; t += delta_t)
     {
@@ -249,13 +251,13 @@ bool planning::drbt::Splines::checkCollision(std::shared_ptr<base::State> q_init
         delta_q = (q_final->getCoord() - q_init->getCoord()).cwiseAbs();
         for (size_t i = 0; i < ss->robot->getNumDOFs(); i++)
         {
-            rho_robot = q_init->getEnclosingRadii()->col(i+1).dot(delta_q);
+            rho_robot = R_init->col(i+1).dot(delta_q);
             if (rho_robot + rho_obs >= q_init->getDistanceProfile(i))    // Possible collision
             {
                 // std::cout << "********** Possible collision ********** \n";
                 q_init = q_final;
                 computeDistanceUnderestimation(q_init, q_current->getNearestPoints(), t_iter);
-                ss->robot->computeEnclosingRadii(q_init);
+                R_init = ss->robot->computeEnclosingRadii(q_init);
                 t_init = t_iter;
 
                 if (q_init->getDistance() <= 0)
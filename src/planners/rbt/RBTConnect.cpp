@@ -29,7 +29,7 @@ bool planning::rbt::RBTConnect::solve()
 		// std::cout << q_e->getCoord().transpose() << "\n";
 		q_near = trees[tree_idx]->getNearestState(q_e);
 		// std::cout << "Tree: " << trees[tree_idx]->getTreeName() << "\n";
-		if (ss->computeDistance(q_near) > RBTConnectConfig::D_CRIT)
+		if (ss->isDistanceGreater(q_near, RBTConnectConfig::D_CRIT))
 		{
 			for (size_t i = 0; i < RBTConnectConfig::NUM_SPINES; i++)
 			{
@@ -149,7 +149,7 @@ std::tuple<base::State::Status, std::shared_ptr<base::State>> planning::rbt::RBT
 base::State::Status planning::rbt::RBTConnect::connectSpine
 	(const std::shared_ptr<base::Tree> tree, const std::shared_ptr<base::State> q, const std::shared_ptr<base::State> q_e)
 {
-	float d_c { ss->computeDistance(q) };
+	bool is_far { ss->isDistanceGreater(q, RBTConnectConfig::D_CRIT) };		// Whether distance-to-obstacles is greater than d_crit
 	std::shared_ptr<base::State> q_new { q };
 	std::shared_ptr<base::State> q_temp { nullptr };
 	base::State::Status status { base::State::Status::Advanced };
@@ -158,10 +158,10 @@ base::State::Status planning::rbt::RBTConnect::connectSpine
 	while (status == base::State::Status::Advanced && num_ext++ < RRTConnectConfig::MAX_EXTENSION_STEPS)
 	{
 		q_temp = q_new;
-		if (d_c > RBTConnectConfig::D_CRIT)
+		if (is_far)
 		{
 			tie(status, q_new) = extendSpine(q_temp, q_e);
-			d_c = ss->computeDistance(q_new);
+			is_far = ss->isDistanceGreater(q_new, RBTConnectConfig::D_CRIT);
 			tree->upgradeTree(q_new, q_temp);
 		}
 		else
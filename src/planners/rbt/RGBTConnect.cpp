@@ -9,6 +9,8 @@ planning::rbt::RGBTConnect::RGBTConnect(const std::shared_ptr<base::StateSpace>
                                         const std::shared_ptr<base::State> q_goal_) : RBTConnect(ss_, q_start_, q_goal_)
 {
     planner_type = planning::PlannerType::RGBTConnect;
+    for (std::shared_ptr<base::Tree> tree : trees)
+        tree->setApproxEps(RGBTConnectConfig::NN_APPROX_EPS);
 }
 
 bool planning::rbt::RGBTConnect::solve()
@@ -30,7 +32,7 @@ bool planning::rbt::RGBTConnect::solve()
 		// std::cout << q_e->getCoord().transpose() << "\n";
 		q_near = trees[tree_idx]->getNearestState(q_e);
 		// std::cout << "Tree: " << trees[tree_idx]->getTreeName() << "\n";
-		if (ss->computeDistance(q_near) > RBTConnectConfig::D_CRIT)
+		if (ss->isDistanceGreater(q_near, RBTConnectConfig::D_CRIT))
 		{
 			for (size_t i = 0; i < RBTConnectConfig::NUM_SPINES; i++)
 			{
@@ -115,7 +117,7 @@ std::tuple<base::State::Status, std::shared_ptr<std::vector<std::shared_ptr<base
 base::State::Status planning::rbt::RGBTConnect::connectGenSpine
 	(const std::shared_ptr<base::Tree> tree, const std::shared_ptr<base::State> q, const std::shared_ptr<base::State> q_e)
 {
-    float d_c { ss->computeDistance(q) };
+    bool is_far { ss->isDistanceGreater(q, RBTConnectConfig::D_CRIT) };	// Whether distance-to-obstacles is greater than d_crit
 	std::shared_ptr<base::State> q_new { q };
 	std::shared_ptr<base::State> q_temp { nullptr };
     std::shared_ptr<std::vector<std::shared_ptr<base::State>>> q_new_list { nullptr };
@@ -125,7 +127,7 @@ base::State::Status planning::rbt::RGBTConnect::connectGenSpine
 	while (status == base::State::Status::Advanced && num_ext++ < RRTConnectConfig::MAX_EXTENSION_STEPS)
 	{
 		q_temp = q_new;
-		if (d_c > RBTConnectConfig::D_CRIT)
+		if (is_far)
 		{
 			tie(status, q_new_list) = extendGenSpine2(q_temp, q_e);
             tree->upgradeTree(q_new_list->front(), q_temp);
@@ -133,7 +135,7 @@ base::State::Status planning::rbt::RGBTConnect::connectGenSpine
                 tree->upgradeTree(q_new_list->at(i), q_new_list->at(i-1));
 			
             q_new = q_new_list->back();
-            d_c = ss->computeDistance(q_new);
+            is_far = ss->isDistanceGreater(q_new, RBTConnectConfig::D_CRIT);
 		}
 		else
 		{
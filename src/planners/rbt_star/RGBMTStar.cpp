@@ -45,8 +45,7 @@ bool planning::rbt_star::RGBMTStar::solve()
         
         // Adding a new local tree rooted in 'q_rand'
         trees.emplace_back(std::make_shared<base::Tree>(base::Tree("local", tree_new_idx)));
-        trees[tree_new_idx]->setKdTree(std::make_shared<base::KdTree>(ss->num_dimensions, *trees[tree_new_idx], 
-                                                                      nanoflann::KDTreeSingleIndexAdaptorParams(10)));
+        trees[tree_new_idx]->setMetricWeights(ss->getMetricWeights());
         trees[tree_new_idx]->upgradeTree(q_rand, nullptr);
         trees_exist.clear();
         trees_reached.clear();
@@ -211,7 +210,7 @@ std::shared_ptr<base::State> planning::rbt_star::RGBMTStar::getRandomState()
 std::tuple<base::State::Status, std::shared_ptr<base::State>> planning::rbt_star::RGBMTStar::connectGenSpine
     (const std::shared_ptr<base::State> q, const std::shared_ptr<base::State> q_e)
 {
-	float d_c { ss->computeDistance(q) };
+	bool is_far { ss->isDistanceGreater(q, RBTConnectConfig::D_CRIT) };	// Whether distance-to-obstacles is greater than d_crit
 	std::shared_ptr<base::State> q_new { q };
     std::shared_ptr<base::State> q_temp { nullptr };
 	base::State::Status status { base::State::Status::Advanced };
@@ -220,17 +219,17 @@ std::tuple<base::State::Status, std::shared_ptr<base::State>> planning::rbt_star
 	while (status == base::State::Status::Advanced)
 	{
 		q_temp = q_new;
-		if (d_c > RBTConnectConfig::D_CRIT)
+		if (is_far)
 		{
 			tie(status, q_new) = extendGenSpine(q_temp, q_e);
-            d_c = ss->computeDistance(q_new);
+            is_far = ss->isDistanceGreater(q_new, RBTConnectConfig::D_CRIT);
 		}
 		else
 		{
 			tie(status, q_new) = extend(q_temp, q_e);
             if (++num_ext > 0.2 * RRTConnectConfig::MAX_EXTENSION_STEPS)
             {
-                d_c = ss->computeDistance(q_new);   
+                is_far = ss->isDistanceGreater(q_new, RBTConnectConfig::D_CRIT);
                 num_ext = 0;
             }
 		}            
@@ -301,6 +300,7 @@ std::shared_ptr<base::State> planning::rbt_star::RGBMTStar::optimize
                 }
             }
             q_reached->setParent(q_opt);
+            tree->refreshState(q_reached->getIdx());
         }
         else
             q_opt = q_reached;
@@ -17,8 +17,10 @@ planning::rrt::RRTConnect::RRTConnect(const std::shared_ptr<base::StateSpace> ss
 		
 	trees.emplace_back(std::make_shared<base::Tree>("q_start", 0));
 	trees.emplace_back(std::make_shared<base::Tree>("q_goal", 1));
-	trees[0]->setKdTree(std::make_shared<base::KdTree>(ss->num_dimensions, *trees[0], nanoflann::KDTreeSingleIndexAdaptorParams(10)));
-	trees[1]->setKdTree(std::make_shared<base::KdTree>(ss->num_dimensions, *trees[1], nanoflann::KDTreeSingleIndexAdaptorParams(10)));
+	trees[0]->setMetricWeights(ss->getMetricWeights());
+	trees[1]->setMetricWeights(ss->getMetricWeights());
+	trees[0]->setApproxEps(RRTConnectConfig::NN_APPROX_EPS);
+	trees[1]->setApproxEps(RRTConnectConfig::NN_APPROX_EPS);
 	trees[0]->upgradeTree(q_start, nullptr);
 	trees[1]->upgradeTree(q_goal, nullptr);
 	planner_info->setNumIterations(0);
@@ -126,21 +128,11 @@ base::State::Status planning::rrt::RRTConnect::connect
 
 void planning::rrt::RRTConnect::computePath()
 {
-	path.clear();
-	std::shared_ptr<base::State> q_con { trees[0]->getStates()->back() };		
-	while (q_con->getParent() != nullptr)
-	{
-		path.emplace_back(q_con->getParent());
-		q_con = q_con->getParent();
-	}
-	std::reverse(path.begin(), path.end());
-
-	q_con = trees[1]->getStates()->back();		
-	while (q_con != nullptr)
-	{
-		path.emplace_back(q_con);
-		q_con = q_con->getParent();
-	}
+	// The last states from both trees are equal, thus the one from 'trees[0]' is skipped
+	std::vector<std::shared_ptr<base::State>> path0 { trees[0]->computePathToRoot(trees[0]->getNumStates() - 1) };
+	std::vector<std::shared_ptr<base::State>> path1 { trees[1]->computePathToRoot(trees[1]->getNumStates() - 1) };
+	path.assign(path0.rbegin(), path0.rend() - 1);
+	path.insert(path.end(), path1.begin(), path1.end());
 }
 
 const std::vector<std::shared_ptr<base::State>> &planning::rrt::RRTConnect::getPath() const
@@ -1,3 +1,248 @@
 #include "AbstractRobot.h"
+#include "RealVectorSpaceState.h"
+#include "RRTConnectConfig.h"
+
+#include <kdl/chainfksolverpos_recursive.hpp>
+#include <kdl/chainiksolvervel_pinv.hpp>
+#include <kdl/chainiksolverpos_nr.hpp>
 
 robots::AbstractRobot::~AbstractRobot() {}
+
+/// @brief Compute skeletons for a batch of N configurations 'q_coords' (each column is one configuration) at once.
+/// @param skeletons Skeletons (resized to 3 (num_links+1) x N), where the row 3 k + r contains the coordinate r 
+/// of the skeleton point k for all configurations.
+/// @note This default implementation computes each skeleton separately, so robots should override it using 'ForwardKinematics::computeBatch'.
+void robots::AbstractRobot::computeSkeletons(const BatchSoA &q_coords, BatchSoA &skeletons)
+{
+	Eigen::MatrixXf skeleton(3, getNumLinks() + 1);
+	skeletons.resize(3 * (getNumLinks() + 1), q_coords.cols());
+	for (Eigen::Index n = 0; n < q_coords.cols(); n++)
+	{
+		computeSkeleton(q_coords.col(n).matrix(), skeleton);
+		skeletons.col(n) = skeleton.reshaped().array();
+	}
+}
+
+
+/// @brief Compute inverse kinematics such that the tip of 'chain' takes the frame 'goal_frame' with respect to the chain root.
+/// @param q_init Initial configuration for the solver. If it is nullptr, random configurations are used until the solution is found.
+/// @return Configuration within joint limits, where angles of revolute joints are set between -PI and PI if possible,
+/// or nullptr if the solution is not found.
+std::shared_ptr<base::State> robots::AbstractRobot::solveInverseKinematics(const KDL::Chain &chain, const KDL::Frame &goal_frame, 
+																		   const std::shared_ptr<base::State> q_init)
+{
+	KDL::ChainFkSolverPos_recursive chain_fk_solver(chain);
+	KDL::ChainIkSolverVel_pinv ik_solver(chain);
+	KDL::ChainIkSolverPos_NR ik_solver_pos(chain, chain_fk_solver, ik_solver, 1000, 1e-5);
+
+	std::vector<bool> is_revolute {};
+	for (size_t s = 0; s < chain.getNrOfSegments(); s++)
+	{
+		const KDL::Joint::JointType joint_type { chain.getSegment(s).getJoint().getType() };
+		if (joint_type != KDL::Joint::None)
+			is_revolute.emplace_back(joint_type == KDL::Joint::RotAxis || joint_type == KDL::Joint::RotX ||
+									 joint_type == KDL::Joint::RotY || joint_type == KDL::Joint::RotZ);
+	}
+
+	KDL::JntArray q_in(num_DOFs);
+	KDL::JntArray q_out(num_DOFs);
+	Eigen::VectorXf q_result(num_DOFs);
+
+	float error { INFINITY };
+	size_t num { 0 };
+	while (error > 1e-5)
+	{
+		if (q_init == nullptr)
+		{
+			Eigen::VectorXf rand { Eigen::VectorXf::Random(num_DOFs) };
+			for (size_t i = 0; i < num_DOFs; i++)
+				q_in.data(i) = ((limits[i].second - limits[i].first) * rand(i) + limits[i].first + limits[i].second) / 2;
+		}
+		else
+		{
+			for (size_t i = 0; i < num_DOFs; i++)
+				q_in.data(i) = q_init->getCoord(i);
+		}
+
+		ik_solver_pos.CartToJnt(q_in, goal_frame, q_out);
+		error = ik_solver_pos.getError();
+		for (size_t i = 0; i < num_DOFs; i++)
+		{
+			q_result(i) = q_out.data(i);
+			if (!is_revolute[i])
+			{
+				if (q_result(i) < limits[i].first || q_result(i) > limits[i].second)
+				{
+					error = INFINITY;	// Try to compute IK again.
+					break;
+				}
+				continue;
+			}
+
+			// Set the angle between -PI and PI
+			q_result(i) = q_out.data(i) - int(q_out.data(i) / (2*M_PI)) * 2*M_PI;
+			if (q_result(i) < -M_PI)
+				q_result(i) += 2*M_PI;
+			else if (q_result(i) > M_PI)
+				q_result(i) -= 2*M_PI;
+
+			if (q_result(i) > limits[i].second)
+			{
+				q_result(i) -= 2*M_PI;
+				if (q_result(i) < limits[i].first)
+				{
+					error = INFINITY; 	// Try to compute IK again.
+					break;
+				}
+			}
+			else if (q_result(i) < limits[i].first)
+			{
+				q_result(i) += 2*M_PI;
+				if (q_result(i) > limits[i].second)
+				{
+					error = INFINITY;	// Try to compute IK again.
+					break;
+				}
+			}
+		}
+
+		if (num++ > 1000)
+		{
+			std::cout << "Unable to compute inverse kinematics for the given input frame! \n";
+			return nullptr;
+		}
+	}
+
+	return std::make_shared<base::RealVectorSpaceState>(q_result);
+}
+
+/// @brief Check if there exists a self-collision when the robot moves from 'q1' to 'q2' following a straight line in C-space.
+/// @param q1 Initial configuration
+/// @param q2 Final configuration
+/// @return True if there exists self-collision. Otherwise, return false.
+/// If there exists self-collision, 'q2' will be modified such that it is equal to a final reached configuration 
+/// from [q1,q2]-line that is collision-free.
+/// @note Only pairs of links from 'self_collision_pairs' are checked. The distance covered by each capsule is bounded 
+/// using enclosing radii of its skeleton points, so skeleton points which are not moved must have zero enclosing radii.
+bool robots::AbstractRobot::checkSelfCollision(const std::shared_ptr<base::State> q1, std::shared_ptr<base::State> &q2)
+{
+	if (!self_collision_checking)
+		return false;
+
+	std::shared_ptr<base::State> q1_temp { q1 };
+	size_t num_iter { 0 };
+	size_t max_num_iter { 5 };
+	std::vector<float> steps(self_collision_pairs.size());
+	float step {};
+	std::shared_ptr<Eigen::MatrixXf> R { nullptr };
+	Eigen::VectorXf delta_q {};
+	Eigen::VectorXf phi {};		// Covered distance by each skeleton point
+
+	while (true)
+	{
+		R = computeEnclosingRadii(q1_temp);
+		delta_q = (q2->getCoord() - q1_temp->getCoord()).cwiseAbs();
+		phi = R->transpose() * delta_q;
+
+		step = INFINITY;
+		for (size_t k = 0; k < self_collision_pairs.size(); k++)
+		{
+			const auto [a, b] = self_collision_pairs[k];
+			steps[k] = computeCapsulesDistance(q1_temp, a, b) / (std::max(phi(a), phi(a+1)) + std::max(phi(b), phi(b+1)));
+			step = std::min(step, steps[k]);
+		}
+
+		if (step > 1)
+			return false;	// Self-collision surely does not occur!
+
+		if (++num_iter == max_num_iter || step <= 0)
+			break;
+
+		if (step > 0)
+			q1_temp = std::make_shared<base::RealVectorSpaceState>(q1_temp->getCoord() + step * (q2->getCoord() - q1_temp->getCoord()));
+	}
+
+	return checkSelfCollision(q1_temp, q2, steps);
+}
+
+/// @brief Check configurations from [q1,q2]-line with the resolution 'RRTConnectConfig::EPS_STEP' for self-collision.
+/// @param steps For each pair from 'self_collision_pairs', a part of [q1,q2]-line which is surely free of its self-collision.
+/// @return True if there exists self-collision, when 'q2' is set to the last collision-free configuration. Otherwise, return false.
+bool robots::AbstractRobot::checkSelfCollision(const std::shared_ptr<base::State> q1, std::shared_ptr<base::State> &q2, 
+											   const std::vector<float> &steps)
+{
+	Eigen::VectorXf q1_temp_coord { q1->getCoord() };
+	Eigen::VectorXf q_new_coord {};
+	std::shared_ptr<base::State> q_new { nullptr };
+	base::State::Status status { base::State::Status::Advanced };
+	const float D { (q2->getCoord() - q1_temp_coord).norm() };
+	float dist { D };
+	float step_crit {};
+	std::vector<bool> skip_checking(self_collision_pairs.size());
+
+	while (status == base::State::Status::Advanced)
+	{
+		if (dist > RRTConnectConfig::EPS_STEP)
+			q_new_coord = q1_temp_coord + (q2->getCoord() - q1_temp_coord) / dist * RRTConnectConfig::EPS_STEP;
+		else
+		{
+			q_new_coord = q2->getCoord();
+			status = base::State::Status::Reached;
+		}
+
+		dist = (q2->getCoord() - q_new_coord).norm();
+		step_crit = 1 - dist / D;
+		for (size_t k = 0; k < self_collision_pairs.size(); k++)
+			skip_checking[k] = steps[k] > step_crit;
+
+		q_new = std::make_shared<base::RealVectorSpaceState>(q_new_coord);
+		if (checkSelfCollision(q_new, skip_checking))
+		{
+			q2 = std::make_shared<base::RealVectorSpaceState>(q1_temp_coord);
+			return true;
+		}
+
+		q1_temp_coord = q_new_coord;
+	}
+
+	return false;
+}
+
+/// @brief Check if there exists a self-collision when the robot takes a configuration 'q'.
+/// @param q A configuration to be considered.
+/// @return True if there exists self-collision. Otherwise, return false.
+/// @note Only pairs of links from 'self_collision_pairs' are checked.
+bool robots::AbstractRobot::checkSelfCollision(const std::shared_ptr<base::State> q)
+{
+	if (!self_collision_checking)
+		return false;
+
+	const std::vector<bool> skip_checking(self_collision_pairs.size(), false);
+	return checkSelfCollision(q, skip_checking);
+}
+
+/// @param skip_checking Determines whether collision checking between each pair from 'self_collision_pairs' can be skipped.
+bool robots::AbstractRobot::checkSelfCollision(const std::shared_ptr<base::State> q, const std::vector<bool> &skip_checking)
+{
+	for (size_t k = 0; k < self_collision_pairs.size(); k++)
+	{
+		const auto [a, b] = self_collision_pairs[k];
+		if (!skip_checking[k] && computeCapsulesDistance(q, a, b) < 0 && checkRealSelfCollision(q, a, b))
+			return true;
+	}
+
+	return false;
+}
+
+/// @brief Compute distance between two corresponding capsules of 'link1_idx'-th and 'link2_idx'-th links.
+/// @param q Configuration of the robot
+/// @param link1_idx Index of the first link
+/// @param link2_idx Index of the second link
+float robots::AbstractRobot::computeCapsulesDistance(const std::shared_ptr<base::State> q, size_t link1_idx, size_t link2_idx)
+{
+	std::shared_ptr<Eigen::MatrixXf> skeleton { computeSkeleton(q) };
+
+	return base::CollisionAndDistance::distanceLineSegToLineSeg
+		   (skeleton->col(link1_idx), skeleton->col(link1_idx+1), skeleton->col(link2_idx), skeleton->col(link2_idx+1), nearest_pts) 
+		   - getCapsuleRadius(link1_idx) - getCapsuleRadius(link2_idx);
+}
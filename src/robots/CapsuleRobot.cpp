@@ -0,0 +1,364 @@
+#include "CapsuleRobot.h"
+
+typedef std::shared_ptr <fcl::CollisionGeometryf> CollisionGeometryPtr;
+
+robots::CapsuleRobot::~CapsuleRobot() {}
+
+robots::CapsuleRobot::CapsuleRobot(const std::string &robot_desc, const std::string &capsules_desc, size_t ground_included_)
+{
+	if (!kdl_parser::treeFromFile(robot_desc, robot_tree))
+		throw std::runtime_error("Failed to construct kdl tree");
+
+	urdf::Model model {};
+	if (!model.initFile(robot_desc))
+		throw std::runtime_error("Failed to parse urdf file");
+
+	readCapsules(capsules_desc);
+	if (!robot_tree.getChain(chain_root, chain_tip, robot_chain))
+		throw std::runtime_error("Failed to get chain from " + chain_root + " to " + chain_tip);
+
+	const size_t last_slash_idx = robot_desc.rfind('/');
+	std::string urdf_root_path = robot_desc.substr(0, last_slash_idx) + "/";
+	type = model.getName();
+	num_DOFs = robot_chain.getNrOfJoints();
+
+	for (size_t s = 0; s < robot_chain.getNrOfSegments(); s++)
+	{
+		const KDL::Segment &segment { robot_chain.getSegment(s) };
+		const KDL::Joint &joint { segment.getJoint() };
+		if (joint.getType() != KDL::Joint::None)
+		{
+			const std::shared_ptr<const urdf::Joint> joint_urdf { model.getJoint(joint.getName()) };
+			if (joint_urdf->type == urdf::Joint::CONTINUOUS || joint_urdf->limits == nullptr)
+				limits.emplace_back(std::pair<float, float>(-M_PI, M_PI));
+			else
+				limits.emplace_back(std::pair<float, float>(joint_urdf->limits->lower, joint_urdf->limits->upper));
+
+			const bool is_revolute { joint.getType() == KDL::Joint::RotAxis || joint.getType() == KDL::Joint::RotX ||
+									 joint.getType() == KDL::Joint::RotY || joint.getType() == KDL::Joint::RotZ };
+			joint_axes.emplace_back(JointAxis { int(s) - 1, joint.JointOrigin(), joint.JointAxis(), is_revolute });
+		}
+
+		const std::shared_ptr<const urdf::Link> link_urdf { model.getLink(segment.getName()) };
+		if (link_urdf == nullptr || link_urdf->collision == nullptr || link_urdf->collision->geometry->type != urdf::Geometry::MESH)
+			continue;
+
+		fcl::Vector3f p[3];
+		fcl::BVHModel<fcl::OBBRSS<float>>* mesh_model { new fcl::BVHModel<fcl::OBBRSS<float>> };
+		mesh_model->beginModel();
+		const auto mesh_ptr { dynamic_cast<const urdf::Mesh*>(link_urdf->collision->geometry.get()) };
+		stl_reader::StlMesh <float, unsigned int> mesh (urdf_root_path + mesh_ptr->filename);
+		for (size_t j = 0; j < mesh.num_tris(); j++)
+		{
+			for (size_t icorner = 0; icorner < 3; icorner++)
+			{
+				const float* c { mesh.vrt_coords (mesh.tri_corner_ind (j, icorner)) };
+				p[icorner] = fcl::Vector3f(c[0], c[1], c[2]);
+			}
+			mesh_model->addTriangle(p[0], p[1], p[2]);
+		}
+		mesh_model->endModel();
+		CollisionGeometryPtr fcl_mesh(mesh_model);
+		links.emplace_back(new fcl::CollisionObject(fcl_mesh, fcl::Transform3f()));
+		link_segments.emplace_back(s);
+	}
+
+	if (skeleton_points.size() != links.size() + 1)
+		throw std::logic_error("Number of skeleton points must be equal to the number of links with collision meshes plus one!");
+
+	if (capsules_radius.size() != links.size())
+		throw std::logic_error("Number of capsules is not correct!");
+
+	for (const std::pair<size_t, size_t> &pair : self_collision_pairs)
+	{
+		if (pair.first + 1 >= pair.second || pair.second >= links.size())
+			throw std::logic_error("Self-collision pair of links is not correct!");
+	}
+
+	num_frames = link_segments.empty() ? 0 : link_segments.back() + 1;
+	for (const SkeletonPoint &point : skeleton_points)
+	{
+		if (point.frame >= int(robot_chain.getNrOfSegments()))
+			throw std::logic_error("Frame of the skeleton point is not correct!");
+
+		num_frames = std::max(num_frames, size_t(point.frame + 1));
+	}
+	for (const JointAxis &joint : joint_axes)
+		num_frames = std::max(num_frames, size_t(joint.frame + 1));
+
+	KDL::TreeFkSolverPos_recursive tree_fk_solver(robot_tree);
+	if (tree_fk_solver.JntToCart(KDL::JntArray(robot_tree.getNrOfJoints()), base_frame, chain_root) < 0)
+		throw std::runtime_error("Failed to compute the frame of " + chain_root);
+
+	fk_solver = robots::ForwardKinematics(robot_tree, chain_root, chain_tip);
+	frames_scratch = std::vector<KDL::Frame>(num_frames);
+	self_collision_checking = true;
+	gripper_length = 0;
+	ground_included = ground_included_;
+	setCapsulesRadius(capsules_radius);
+	setState(std::make_shared<base::RealVectorSpaceState>(Eigen::VectorXf::Zero(num_DOFs)));
+
+	LOG(INFO) << type << " robot created.";
+}
+
+/// @brief Read the capsule model from the YAML file 'capsules_desc'.
+/// If self-collision pairs are not given, all pairs of non-adjacent links are checked.
+void robots::CapsuleRobot::readCapsules(const std::string &capsules_desc)
+{
+	YAML::Node node { YAML::LoadFile(capsules_desc) };
+	chain_root = node["chain"]["root"].as<std::string>();
+	chain_tip = node["chain"]["tip"].as<std::string>();
+
+	for (const YAML::Node &point_node : node["skeleton"])
+	{
+		YAML::Node offset_node { point_node["offset"] };
+		if (offset_node.size() != 3)
+			throw std::logic_error("Offset of the skeleton point is not correct!");
+
+		skeleton_points.emplace_back(SkeletonPoint { point_node["frame"].as<int>(),
+			KDL::Vector(offset_node[0].as<double>(), offset_node[1].as<double>(), offset_node[2].as<double>()) });
+	}
+
+	for (const YAML::Node &radius_node : node["capsules_radius"])
+		capsules_radius.emplace_back(radius_node.as<float>());
+
+	YAML::Node pairs_node { node["self_collision_pairs"] };
+	if (pairs_node.IsDefined())
+	{
+		for (const YAML::Node &pair_node : pairs_node)
+			self_collision_pairs.emplace_back(std::pair<size_t, size_t>(pair_node[0].as<size_t>(), pair_node[1].as<size_t>()));
+	}
+	else
+	{
+		const size_t num_links { skeleton_points.empty() ? 0 : skeleton_points.size() - 1 };
+		for (size_t i = 0; i < num_links; i++)
+			for (size_t j = i + 2; j < num_links; j++)
+				self_collision_pairs.emplace_back(std::pair<size_t, size_t>(i, j));
+	}
+
+	YAML::Node tool_length_node { node["tool_length"] };
+	tool_length = tool_length_node.IsDefined() ? tool_length_node.as<float>() : 0;
+}
+
+void robots::CapsuleRobot::setState(const std::shared_ptr<base::State> q)
+{
+	std::shared_ptr<std::vector<KDL::Frame>> frames_fk { computeForwardKinematics(q) };
+	for (size_t i = 0; i < links.size(); i++)
+	{
+		links[i]->setTransform(KDL2fcl(frames_fk->at(link_segments[i])));
+		links[i]->computeAABB();
+	}
+}
+
+void robots::CapsuleRobot::setCapsulesRadius(const std::vector<float> &capsules_radius_)
+{
+	capsules_radius = capsules_radius_;
+	capsules_radius_new = std::vector<float>(capsules_radius.size());
+	for (size_t i = 0; i + 1 < capsules_radius.size(); i++)
+		capsules_radius_new[i] = std::max(capsules_radius[i], capsules_radius[i+1]);
+	if (!capsules_radius.empty())
+		capsules_radius_new.back() = capsules_radius.back();
+}
+
+std::shared_ptr<std::vector<KDL::Frame>> robots::CapsuleRobot::computeForwardKinematics(const std::shared_ptr<base::State> q)
+{
+	setConfiguration(q);
+
+	if (q->getFrames() != nullptr)		// It has been already computed!
+	{
+		cacheHit(q);
+		return q->getFrames();
+	}
+
+	std::shared_ptr<std::vector<KDL::Frame>> frames_fk { std::make_shared<std::vector<KDL::Frame>>(num_frames) };
+	computeForwardKinematics(q->getCoord(), *frames_fk);
+
+	q->setFrames(frames_fk);
+	cacheMiss(q);
+	return frames_fk;
+}
+
+// Compute frames of the first 'num_frames' chain segments for the configuration 'q_coord' into 'frames_fk',
+// which must have 'num_frames' elements. No heap allocation occurs.
+void robots::CapsuleRobot::computeForwardKinematics(const Eigen::VectorXf &q_coord, std::vector<KDL::Frame> &frames_fk)
+{
+	fk_solver.compute(q_coord, frames_fk);
+}
+
+/// @brief Compute inverse kinematics such that the chain tip takes the frame given by 'R' and 'p' with respect to the tree root.
+std::shared_ptr<base::State> robots::CapsuleRobot::computeInverseKinematics(const KDL::Rotation &R, const KDL::Vector &p,
+																			const std::shared_ptr<base::State> q_init)
+{
+	return solveInverseKinematics(robot_chain, base_frame.Inverse() * KDL::Frame(R, p), q_init);	// Chain solvers are relative to the chain root
+}
+
+std::shared_ptr<Eigen::MatrixXf> robots::CapsuleRobot::computeSkeleton(const std::shared_ptr<base::State> q)
+{
+	if (q->getSkeleton() != nullptr)	// It has been already computed!
+	{
+		cacheHit(q);
+		return q->getSkeleton();
+	}
+
+	std::shared_ptr<std::vector<KDL::Frame>> frames { computeForwardKinematics(q) };
+	std::shared_ptr<Eigen::MatrixXf> skeleton { std::make_shared<Eigen::MatrixXf>(3, skeleton_points.size()) };
+	computeSkeleton(*frames, *skeleton);
+
+	q->setSkeleton(skeleton);
+	cacheMiss(q);
+	return skeleton;
+}
+
+// Compute skeleton for the configuration 'q_coord' without creating a state, i.e., frames and skeleton are not stored.
+// If 'skeleton' is already of size 3 x (num_links+1), no heap allocation occurs.
+void robots::CapsuleRobot::computeSkeleton(const Eigen::VectorXf &q_coord, Eigen::MatrixXf &skeleton)
+{
+	computeForwardKinematics(q_coord, frames_scratch);
+	skeleton.resize(3, skeleton_points.size());
+	computeSkeleton(frames_scratch, skeleton);
+}
+
+void robots::CapsuleRobot::computeSkeleton(const std::vector<KDL::Frame> &frames, Eigen::MatrixXf &skeleton)
+{
+	for (size_t k = 0; k < skeleton_points.size(); k++)
+	{
+		KDL::Vector p { getFrame(frames, skeleton_points[k].frame) * skeleton_points[k].offset };
+		skeleton.col(k) << p.x(), p.y(), p.z();
+	}
+}
+
+// Compute skeletons for a batch of configurations 'q_coords' at once (see 'AbstractRobot::computeSkeletons'),
+// which gives the same result as 'computeSkeleton' for each configuration.
+// Only nonzero offset components of skeleton points are added, so the cost is the same as for a hand-coded skeleton.
+void robots::CapsuleRobot::computeSkeletons(const BatchSoA &q_coords, BatchSoA &skeletons)
+{
+	fk_solver.computeBatch(q_coords, frames_batch_scratch, num_frames);
+	skeletons.resize(3 * skeleton_points.size(), q_coords.cols());
+
+	for (size_t k = 0; k < skeleton_points.size(); k++)
+	{
+		const SkeletonPoint &point { skeleton_points[k] };
+		if (point.frame < 0)	// Skeleton point is fixed
+		{
+			KDL::Vector p { base_frame * point.offset };
+			for (size_t r = 0; r < 3; r++)
+				skeletons.row(3*k + r).setConstant(p(r));
+			continue;
+		}
+
+		const size_t i = point.frame;
+		for (size_t r = 0; r < 3; r++)
+		{
+			skeletons.row(3*k + r) = frames_batch_scratch.row(12*i + 9 + r);	// Translation of the frame i
+			for (size_t c = 0; c < 3; c++)
+			{
+				if (point.offset(c) != 0)	// Column c of the rotation of the frame i
+					skeletons.row(3*k + r) += float(point.offset(c)) * frames_batch_scratch.row(12*i + 3*r + c);
+			}
+		}
+	}
+}
+
+/// @brief Compute enclosing radii, where R(i, j) bounds the distance covered by skeleton point j (and its capsules)
+/// when the joint i moves by one unit, taking the maximum over previous skeleton points.
+/// For a revolute joint, it is the distance of the skeleton point to the joint axis, which generalizes projections
+/// used for xArm6 robot. For a prismatic joint, it is one. Skeleton points which are not moved by the joint are skipped,
+/// as well as skeleton points on the axis of a revolute joint, e.g., the last one, which is rotated only about its own axis.
+/// A capsule ending at such a point is then covered by its other skeleton point, if it is moved.
+std::shared_ptr<Eigen::MatrixXf> robots::CapsuleRobot::computeEnclosingRadii(const std::shared_ptr<base::State> q)
+{
+	if (q->getEnclosingRadii() != nullptr)	// It has been already computed!
+	{
+		cacheHit(q);
+		return q->getEnclosingRadii();
+	}
+
+	std::shared_ptr<std::vector<KDL::Frame>> frames { computeForwardKinematics(q) };
+	std::shared_ptr<Eigen::MatrixXf> skeleton { computeSkeleton(q) };
+	const size_t num_links { getNumLinks() };
+	Eigen::MatrixXf R { Eigen::MatrixXf::Zero(num_DOFs, num_links+1) };
+	Eigen::Vector3f origin {}, axis {}, arm {};
+	float dist {};
+
+	for (size_t i = 0; i < num_DOFs; i++)
+	{
+		const JointAxis &joint { joint_axes[i] };
+		const KDL::Frame &frame { getFrame(*frames, joint.frame) };
+		KDL::Vector origin_kdl { frame * joint.origin };
+		KDL::Vector axis_kdl { frame.M * joint.axis };
+		origin << origin_kdl.x(), origin_kdl.y(), origin_kdl.z();
+		axis << axis_kdl.x(), axis_kdl.y(), axis_kdl.z();
+		axis.normalize();
+
+		for (size_t j = 1; j <= num_links; j++)
+		{
+			R(i, j) = R(i, j-1);
+			if (skeleton_points[j].frame <= joint.frame)	// Skeleton point j is not moved by the joint i
+				continue;
+
+			if (joint.is_revolute)
+			{
+				arm = skeleton->col(j) - origin;
+				dist = arm.cross(axis).norm();
+				if (dist > 1e-5)	// Otherwise, skeleton point j is on the axis
+					R(i, j) = std::max(R(i, j), dist + capsules_radius_new[j-1]);
+			}
+			else
+				R(i, j) = std::max(R(i, j), 1.f);
+		}
+	}
+
+	q->setEnclosingRadii(std::make_shared<Eigen::MatrixXf>(R));
+	cacheMiss(q);
+	return q->getEnclosingRadii();
+}
+
+/// @brief Check self-collision between meshes of 'link1_idx'-th and 'link2_idx'-th links, where 'link1_idx' < 'link2_idx'.
+/// If the tool is attached, it is approximated by an enclosing capsule of the last link, which ends at the last skeleton point.
+bool robots::CapsuleRobot::checkRealSelfCollision(const std::shared_ptr<base::State> q, size_t link1_idx, size_t link2_idx)
+{
+	setState(q);
+
+	if (checkCollisionFCL(links[link1_idx], links[link2_idx]))
+		return true;
+
+	if (tool_length > 0 && link2_idx == getNumLinks() - 1)
+	{
+		std::shared_ptr<Eigen::MatrixXf> skeleton { computeSkeleton(q) };
+		Eigen::Vector3f B { skeleton->col(link2_idx+1) };
+		Eigen::Vector3f A { B - tool_length * (B - skeleton->col(link2_idx)).normalized() };
+
+		CollisionGeometryPtr tool(new fcl::Capsulef(getCapsuleRadius(link2_idx), tool_length));
+		std::unique_ptr<fcl::CollisionObjectf> tool_fcl(new fcl::CollisionObjectf(tool, fcl::Transform3f()));
+		tool_fcl->setTranslation((A + B) / 2);
+		tool_fcl->setRotation(Eigen::Quaternionf::FromTwoVectors(Eigen::Vector3f::UnitZ(), B - A).toRotationMatrix());
+		tool_fcl->computeAABB();
+
+		if (checkCollisionFCL(links[link1_idx], tool_fcl))
+			return true;
+	}
+
+	return false;
+}
+
+bool robots::CapsuleRobot::checkCollisionFCL(const std::unique_ptr<fcl::CollisionObjectf> &obj1, const std::unique_ptr<fcl::CollisionObjectf> &obj2)
+{
+	fcl::CollisionRequest<float> request {};
+	fcl::CollisionResult<float> result {};
+	fcl::collide(obj1.get(), obj2.get(), request, result);
+
+	return result.isCollision();
+}
+
+fcl::Transform3f robots::CapsuleRobot::KDL2fcl(const KDL::Frame &in)
+{
+	fcl::Transform3f out {};
+	double x { 0 }, y { 0 }, z { 0 }, w { 0 };
+	in.M.GetQuaternion(x, y, z, w);
+	fcl::Vector3f t(in.p[0], in.p[1], in.p[2]);
+	fcl::Quaternionf q(w, x, y, z);
+	out.linear() = q.matrix();
+	out.translation() = t;
+
+	return out;
+}
@@ -0,0 +1,213 @@
+#include "ForwardKinematics.h"
+
+/// @brief Extract all segments from 'chain_root' to 'chain_tip' in 'tree', and their joint types, axes and origins.
+/// Frames are expressed with respect to the root of 'tree' (as in 'KDL::TreeFkSolverPos_recursive'), 
+/// so the fixed pose of 'chain_root' is precomputed as well.
+/// @note Joints are assumed to be without scale and offset (as generated by 'kdl_parser'), which is verified here.
+robots::ForwardKinematics::ForwardKinematics(const KDL::Tree &tree, const std::string &chain_root, const std::string &chain_tip)
+{
+	KDL::Chain chain {};
+	if (!tree.getChain(chain_root, chain_tip, chain))
+		throw std::runtime_error("Failed to extract kdl chain from " + chain_root + " to " + chain_tip);
+
+	KDL::Frame base_frame {};
+	KDL::TreeFkSolverPos_recursive(tree).JntToCart(KDL::JntArray(tree.getNrOfJoints()), base_frame, chain_root);
+	const Eigen::Matrix3f R_base { Eigen::Map<const Eigen::Matrix<double, 3, 3, Eigen::RowMajor>>(base_frame.M.data).cast<float>() };
+	const Eigen::Vector3f p_base { Eigen::Map<const Eigen::Vector3d>(base_frame.p.data).cast<float>() };
+	num_joints = chain.getNrOfJoints();
+
+	for (size_t i = 0; i < chain.getNrOfSegments(); i++)
+	{
+		const KDL::Segment &kdl_segment { chain.getSegment(i) };
+		const KDL::Joint &joint { kdl_segment.getJoint() };
+		const KDL::Frame tip { kdl_segment.getFrameToTip() };
+		const Eigen::Matrix3f R_tip { Eigen::Map<const Eigen::Matrix<double, 3, 3, Eigen::RowMajor>>(tip.M.data).cast<float>() };
+		const Eigen::Vector3f p_tip { Eigen::Map<const Eigen::Vector3d>(tip.p.data).cast<float>() };
+		const Eigen::Vector3f origin { Eigen::Map<const Eigen::Vector3d>(joint.JointOrigin().data).cast<float>() };
+		Segment segment {};
+		segment.axis = Eigen::Map<const Eigen::Vector3d>(joint.JointAxis().data).cast<float>();
+		segment.A.setZero();
+		segment.B.setZero();
+		segment.u.setZero();
+		segment.v.setZero();
+
+		switch (joint.getType())
+		{
+		case KDL::Joint::RotAxis: case KDL::Joint::RotX: case KDL::Joint::RotY: case KDL::Joint::RotZ:
+		{
+			// Rotation about 'axis' through 'origin' (Rodrigues' formula), followed by the tip frame
+			segment.joint_type = JointType::Revolute;
+			const Eigen::Matrix3f aa { segment.axis * segment.axis.transpose() };
+			Eigen::Matrix3f K {};
+			K << 0, -segment.axis.z(), segment.axis.y(),
+				 segment.axis.z(), 0, -segment.axis.x(),
+				 -segment.axis.y(), segment.axis.x(), 0;
+			segment.A = (Eigen::Matrix3f::Identity() - aa) * R_tip;
+			segment.B = K * R_tip;
+			segment.C = aa * R_tip;
+			segment.u = (Eigen::Matrix3f::Identity() - aa) * (p_tip - origin);
+			segment.v = K * (p_tip - origin);
+			segment.w = aa * (p_tip - origin) + origin;
+			break;
+		}
+		case KDL::Joint::TransAxis: case KDL::Joint::TransX: case KDL::Joint::TransY: case KDL::Joint::TransZ:
+			segment.joint_type = JointType::Prismatic;
+			segment.C = R_tip;
+			segment.w = p_tip;
+			break;
+		default:
+			segment.joint_type = JointType::Fixed;
+			segment.C = R_tip;
+			segment.w = p_tip;
+			break;
+		}
+
+		// Verify the segment pose against KDL for some joint value
+		const float q { segment.joint_type == JointType::Fixed ? 0.f : 1.f };
+		const KDL::Frame pose { kdl_segment.pose(q) };
+		Eigen::Matrix3f R {};
+		Eigen::Vector3f p {};
+		computeSegmentPose(segment, q, R, p);
+		if (!R.isApprox(Eigen::Map<const Eigen::Matrix<double, 3, 3, Eigen::RowMajor>>(pose.M.data).cast<float>(), 1e-4) ||
+			!p.isApprox(Eigen::Map<const Eigen::Vector3d>(pose.p.data).cast<float>(), 1e-4))
+			throw std::runtime_error("Unsupported joint " + joint.getName() + " for forward kinematics");
+
+		if (i == 0)		// Fold the pose of the chain root into the first segment
+		{
+			segment.axis = R_base * segment.axis;
+			segment.A = R_base * segment.A;
+			segment.B = R_base * segment.B;
+			segment.C = R_base * segment.C;
+			segment.u = R_base * segment.u;
+			segment.v = R_base * segment.v;
+			segment.w = R_base * segment.w + p_base;
+		}
+		segments.emplace_back(segment);
+	}
+}
+
+// Compute the pose (rotation 'R' and translation 'p') of the tip of 'segment' with respect to its parent, 
+// when its joint takes the value 'q'.
+void robots::ForwardKinematics::computeSegmentPose(const Segment &segment, float q, Eigen::Matrix3f &R, Eigen::Vector3f &p) const
+{
+	switch (segment.joint_type)
+	{
+	case JointType::Revolute:
+	{
+		const float c { std::cos(q) }, s { std::sin(q) };
+		R.noalias() = c * segment.A + s * segment.B + segment.C;
+		p.noalias() = c * segment.u + s * segment.v + segment.w;
+		break;
+	}
+	case JointType::Prismatic:
+		R = segment.C;
+		p.noalias() = q * segment.axis + segment.w;
+		break;
+	default:
+		R = segment.C;
+		p = segment.w;
+		break;
+	}
+}
+
+/// @brief Compute frames of the first 'frames.size()' segments for the configuration 'q_coord' in a single forward pass.
+/// Each frame is obtained from the previous one, so no heap allocation occurs.
+/// @param q_coord Joint values of the chain.
+/// @param frames Frames of segment tips with respect to the tree root, where 'frames.size()' must not exceed 'getNumSegments()'.
+void robots::ForwardKinematics::compute(const Eigen::VectorXf &q_coord, std::vector<KDL::Frame> &frames) const
+{
+	Eigen::Matrix3f R { Eigen::Matrix3f::Identity() }, R_segment {};
+	Eigen::Vector3f p { Eigen::Vector3f::Zero() }, p_segment {};
+	size_t idx_joint { 0 };
+
+	for (size_t i = 0; i < frames.size(); i++)
+	{
+		computeSegmentPose(segments[i], segments[i].joint_type == JointType::Fixed ? 0.f : q_coord(idx_joint++), R_segment, p_segment);
+		p += R * p_segment;
+		R = R * R_segment;
+
+		frames[i].M = KDL::Rotation(R(0, 0), R(0, 1), R(0, 2), R(1, 0), R(1, 1), R(1, 2), R(2, 0), R(2, 1), R(2, 2));
+		frames[i].p = KDL::Vector(p(0), p(1), p(2));
+	}
+}
+
+/// @brief Compute frames of the first 'num_frames' segments for a batch of N configurations at once.
+/// Configurations are processed in chunks of fixed size, where each quantity of the forward pass is an array over 
+/// the whole chunk, so the compiler vectorises the computation across configurations without any heap allocation.
+/// @param q_coords Joint values of N configurations, where the row j contains the joint j of all configurations.
+/// @param frames Frames of segment tips with respect to the tree root (resized to 12 num_frames x N), where the frame i occupies 
+/// rows from 12 i to 12 i + 11, i.e., the element (r, c) of its rotation is in the row 12 i + 3 r + c, 
+/// and the element r of its translation is in the row 12 i + 9 + r.
+void robots::ForwardKinematics::computeBatch(const BatchSoA &q_coords, BatchSoA &frames, size_t num_frames) const
+{
+	const Eigen::Index N { q_coords.cols() };
+	frames.resize(12 * num_frames, N);
+	Chunk R[9], p[3];				// Frame of the current segment
+	Chunk R_segment[9], p_segment[3];
+	Chunk R_new[9];
+	Chunk q {}, cos_q {}, sin_q {};
+
+	for (Eigen::Index n = 0; n < N; n += Chunk::SizeAtCompileTime)
+	{
+		const Eigen::Index len { std::min<Eigen::Index>(Chunk::SizeAtCompileTime, N - n) };
+		size_t idx_joint { 0 };
+		q.setZero();	// Unused elements of the last chunk must be finite
+
+		for (size_t i = 0; i < num_frames; i++)
+		{
+			const Segment &segment { segments[i] };
+			switch (segment.joint_type)
+			{
+			case JointType::Revolute:
+				q.head(len) = q_coords.row(idx_joint++).segment(n, len);
+				cos_q = q.cos();
+				sin_q = q.sin();
+				for (size_t r = 0; r < 3; r++)
+				{
+					for (size_t c = 0; c < 3; c++)
+						R_segment[3*r + c] = segment.A(r, c) * cos_q + segment.B(r, c) * sin_q + segment.C(r, c);
+					p_segment[r] = segment.u(r) * cos_q + segment.v(r) * sin_q + segment.w(r);
+				}
+				break;
+			case JointType::Prismatic:
+				q.head(len) = q_coords.row(idx_joint++).segment(n, len);
+				for (size_t r = 0; r < 3; r++)
+				{
+					for (size_t c = 0; c < 3; c++)
+						R_segment[3*r + c].setConstant(segment.C(r, c));
+					p_segment[r] = segment.axis(r) * q + segment.w(r);
+				}
+				break;
+			default:
+				for (size_t r = 0; r < 3; r++)
+				{
+					for (size_t c = 0; c < 3; c++)
+						R_segment[3*r + c].setConstant(segment.C(r, c));
+					p_segment[r].setConstant(segment.w(r));
+				}
+				break;
+			}
+
+			if (i == 0)		// The first frame is the pose of the first segment itself
+			{
+				std::copy(R_segment, R_segment + 9, R);
+				std::copy(p_segment, p_segment + 3, p);
+			}
+			else			// R = R * R_segment, and p = p + R * p_segment
+			{
+				for (size_t r = 0; r < 3; r++)
+				{
+					p[r] += R[3*r] * p_segment[0] + R[3*r + 1] * p_segment[1] + R[3*r + 2] * p_segment[2];
+					for (size_t c = 0; c < 3; c++)
+						R_new[3*r + c] = R[3*r] * R_segment[c] + R[3*r + 1] * R_segment[3 + c] + R[3*r + 2] * R_segment[6 + c];
+				}
+				std::copy(R_new, R_new + 9, R);
+			}
+
+			for (size_t k = 0; k < 9; k++)
+				frames.row(12*i + k).segment(n, len) = R[k].head(len);
+			for (size_t r = 0; r < 3; r++)
+				frames.row(12*i + 9 + r).segment(n, len) = p[r].head(len);
+		}
+	}
+}
@@ -2,17 +2,72 @@
 
 robots::Planar10DOF::~Planar10DOF() {}
 
-robots::Planar10DOF::Planar10DOF(const std::string &robot_desc) : Planar2DOF(robot_desc, 10) {}
+robots::Planar10DOF::Planar10DOF(const std::string &robot_desc) : Planar2DOF(robot_desc, 10)
+{
+	for (size_t i = 0; i < num_DOFs; i++)
+	{
+		for (size_t j = i+2; j < num_DOFs; j++)
+			self_collision_pairs.emplace_back(i, j);
+	}
+
+	self_collision_checking = true;
+}
 
-bool robots::Planar10DOF::checkSelfCollision([[maybe_unused]] const std::shared_ptr<base::State> q1, 
-											 [[maybe_unused]] std::shared_ptr<base::State> &q2)
+/// @brief Check if there exists a self-collision when the robot moves from 'q1' to 'q2' following a straight line in C-space.
+/// @param q1 Initial configuration
+/// @param q2 Final configuration
+/// @return True if there exists self-collision. Otherwise, return false.
+/// If there exists self-collision, 'q2' will be modified such that it is equal to a final reached configuration 
+/// from [q1,q2]-line that is collision-free.
+/// @note Links 'a' and 'b' (a < b) are moved together by joints up to 'a', so only joints from 'a+1' to 'b' 
+/// can change the distance between their capsules. Thus, only these joints are used to bound the covered distance of each pair.
+bool robots::Planar10DOF::checkSelfCollision(const std::shared_ptr<base::State> q1, std::shared_ptr<base::State> &q2)
 {
-    // TODO (if needed)
-	return false;
+	if (!self_collision_checking)
+		return false;
+
+	std::shared_ptr<base::State> q1_temp { q1 };
+	size_t num_iter { 0 };
+	size_t max_num_iter { 5 };
+	std::vector<float> steps(self_collision_pairs.size());
+	float step {}, phi {};
+	std::shared_ptr<Eigen::MatrixXf> R { nullptr };
+	Eigen::VectorXf delta_q {};
+
+	while (true)
+	{
+		R = computeEnclosingRadii(q1_temp);
+		delta_q = (q2->getCoord() - q1_temp->getCoord()).cwiseAbs();
+		step = INFINITY;
+		for (size_t k = 0; k < self_collision_pairs.size(); k++)
+		{
+			const auto [a, b] = self_collision_pairs[k];
+			phi = R->block(a+1, b, b-a, 2).rowwise().maxCoeff().dot(delta_q.segment(a+1, b-a));	// Covered distance by link 'b' relative to link 'a'
+			steps[k] = computeCapsulesDistance(q1_temp, a, b) / phi;
+			step = std::min(step, steps[k]);
+		}
+
+		if (step > 1)
+		{
+			// std::cout << "Self-collision surely does not occur! \n";
+			return false;
+		}
+
+		if (++num_iter == max_num_iter || step <= 0)
+			break;
+
+		if (step > 0)
+			q1_temp = std::make_shared<base::RealVectorSpaceState>(q1_temp->getCoord() + step * (q2->getCoord() - q1_temp->getCoord()));
+	}
+
+	return AbstractRobot::checkSelfCollision(q1_temp, q2, steps);
 }
 
-bool robots::Planar10DOF::checkSelfCollision([[maybe_unused]] const std::shared_ptr<base::State> q)
+/// @brief Check if there exists a self-collision when the Planar10DOF robot takes a configuration 'q'.
+/// @param q A configuration to be considered.
+/// @return True if there exists self-collision. Otherwise, return false.
+/// @note Self-collision is checked between capsules of all pairs of non-adjacent links.
+bool robots::Planar10DOF::checkSelfCollision(const std::shared_ptr<base::State> q)
 {
-	// TODO (if needed)
-	return false;
+	return AbstractRobot::checkSelfCollision(q);
 }
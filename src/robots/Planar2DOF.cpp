@@ -53,6 +53,10 @@ robots::Planar2DOF::Planar2DOF(const std::string &robot_desc, size_t num_DOFs_)
 	}
 	
 	robot_tree.getChain("base_link", "tool", robot_chain);
+	fk_solver = robots::ForwardKinematics(robot_tree, "base_link", "tool");
+	tree_fk_solver = std::make_unique<KDL::TreeFkSolverPos_recursive>(robot_tree);
+	joint_pos = KDL::JntArray(num_DOFs);
+	frames_scratch = std::vector<KDL::Frame>(robot_tree.getNrOfSegments());
 	Eigen::VectorXf state { Eigen::VectorXf::Zero(num_DOFs) };
 	setState(std::make_shared<base::RealVectorSpaceState>(state));
 	self_collision_checking = false;
@@ -84,27 +88,39 @@ std::shared_ptr<std::vector<KDL::Frame>> robots::Planar2DOF::computeForwardKinem
 	setConfiguration(q);
 	
 	if (q->getFrames() != nullptr)		// It has been already computed!
+	{
+		cacheHit(q);
 		return q->getFrames();
+	}
 
-	KDL::TreeFkSolverPos_recursive tree_fk_solver(robot_tree);
-	std::vector<KDL::Frame> frames_fk(robot_tree.getNrOfSegments());
-	robot_tree.getChain("base_link", "tool", robot_chain);
-	KDL::JntArray joint_pos { KDL::JntArray(num_DOFs) };
+	std::shared_ptr<std::vector<KDL::Frame>> frames_fk { std::make_shared<std::vector<KDL::Frame>>(robot_tree.getNrOfSegments()) };
+	computeForwardKinematics(q->getCoord(), *frames_fk);
+	
+	q->setFrames(frames_fk);
+	cacheMiss(q);
+	return frames_fk;
+}
+
+// Compute frames of all segments for the configuration 'q_coord' into 'frames_fk', which must have 'robot_tree.getNrOfSegments()' elements.
+// All frames are computed in a single forward pass by 'fk_solver', so no heap allocation occurs.
+void robots::Planar2DOF::computeForwardKinematics(const Eigen::VectorXf &q_coord, std::vector<KDL::Frame> &frames_fk)
+{
+	fk_solver.compute(q_coord, frames_fk);
+}
 
+// The same as 'computeForwardKinematics', but using KDL tree solver for each segment separately.
+// It is kept as a reference for testing 'fk_solver'.
+void robots::Planar2DOF::computeForwardKinematicsKDL(const Eigen::VectorXf &q_coord, std::vector<KDL::Frame> &frames_fk)
+{
 	for (size_t i = 0; i < num_DOFs; i++)
-		joint_pos(i) = q->getCoord(i);
+		joint_pos(i) = q_coord(i);
 	
-	for (size_t i = 0; i < robot_tree.getNrOfSegments(); i++)
+	for (size_t i = 0; i < frames_fk.size(); i++)
 	{
-		KDL::Frame cart_pos {};
-		tree_fk_solver.JntToCart(joint_pos, cart_pos, robot_chain.getSegment(i).getName());
-		frames_fk[i] = cart_pos;
+		tree_fk_solver->JntToCart(joint_pos, frames_fk[i], robot_chain.getSegment(i).getName());
 		// std::cout << "Frame R" << i << ": " << frames_fk[i].M << "\n";
 		// std::cout << "Frame p" << i << ": " << frames_fk[i].p << "\n";
 	}
-	
-	q->setFrames(std::make_shared<std::vector<KDL::Frame>>(frames_fk));
-	return q->getFrames();
 }
 
 std::shared_ptr<base::State> robots::Planar2DOF::computeInverseKinematics([[maybe_unused]] const KDL::Rotation &R, [[maybe_unused]] const KDL::Vector &p, 
@@ -117,7 +133,10 @@ std::shared_ptr<base::State> robots::Planar2DOF::computeInverseKinematics([[mayb
 std::shared_ptr<Eigen::MatrixXf> robots::Planar2DOF::computeSkeleton(const std::shared_ptr<base::State> q)
 {
 	if (q->getSkeleton() != nullptr)	// It has been already computed!
+	{
+		cacheHit(q);
 		return q->getSkeleton();
+	}
 		
 	std::shared_ptr<std::vector<KDL::Frame>> frames { computeForwardKinematics(q) };
 	std::shared_ptr<Eigen::MatrixXf> skeleton { std::make_shared<Eigen::MatrixXf>(3, num_DOFs + 1) };
@@ -126,13 +145,39 @@ std::shared_ptr<Eigen::MatrixXf> robots::Planar2DOF::computeSkeleton(const std::
 		skeleton->col(k) << frames->at(k).p(0), frames->at(k).p(1), frames->at(k).p(2);
 	
 	q->setSkeleton(skeleton);
+	cacheMiss(q);
 	return skeleton;
 }
 
+// Compute skeleton for the configuration 'q_coord' without creating a state, i.e., frames and skeleton are not stored.
+// If 'skeleton' is already of size 3 x (num_DOFs+1), no heap allocation occurs.
+void robots::Planar2DOF::computeSkeleton(const Eigen::VectorXf &q_coord, Eigen::MatrixXf &skeleton)
+{
+	computeForwardKinematics(q_coord, frames_scratch);
+	skeleton.resize(3, num_DOFs + 1);
+
+	for (size_t k = 0; k <= num_DOFs; k++)
+		skeleton.col(k) << frames_scratch[k].p(0), frames_scratch[k].p(1), frames_scratch[k].p(2);
+}
+
+// Compute skeletons for a batch of configurations 'q_coords' at once (see 'AbstractRobot::computeSkeletons'), 
+// which gives the same result as 'computeSkeleton' for each configuration.
+void robots::Planar2DOF::computeSkeletons(const BatchSoA &q_coords, BatchSoA &skeletons)
+{
+	fk_solver.computeBatch(q_coords, frames_batch_scratch, num_DOFs + 1);
+	skeletons.resize(3 * (num_DOFs + 1), q_coords.cols());
+
+	for (size_t k = 0; k <= num_DOFs; k++)
+		skeletons.middleRows(3*k, 3) = frames_batch_scratch.middleRows(12*k + 9, 3);
+}
+
 std::shared_ptr<Eigen::MatrixXf> robots::Planar2DOF::computeEnclosingRadii(const std::shared_ptr<base::State> q)
 {
 	if (q->getEnclosingRadii() != nullptr)	// It has been already computed!
+	{
+		cacheHit(q);
 		return q->getEnclosingRadii();
+	}
 
 	std::shared_ptr<Eigen::MatrixXf> skeleton { computeSkeleton(q) };
 	Eigen::MatrixXf R { Eigen::MatrixXf::Zero(num_DOFs, num_DOFs+1) };
@@ -144,6 +189,7 @@ std::shared_ptr<Eigen::MatrixXf> robots::Planar2DOF::computeEnclosingRadii(const
 	}
 
 	q->setEnclosingRadii(std::make_shared<Eigen::MatrixXf>(R));
+	cacheMiss(q);
 	return q->getEnclosingRadii();
 }
 
@@ -62,6 +62,11 @@ robots::xArm6::xArm6(const std::string &robot_desc, float gripper_length_, size_
 		}
 	}
 	
+	fk_solver = robots::ForwardKinematics(robot_tree, "link_base", "link_eef");
+	tree_fk_solver = std::make_unique<KDL::TreeFkSolverPos_recursive>(robot_tree);
+	joint_pos = KDL::JntArray(num_DOFs);
+	frames_scratch = std::vector<KDL::Frame>(num_DOFs);
+	self_collision_pairs = { {0, 5}, {1, 5}, {0, 4}, {1, 4} };	// Because of joint limits, only first two links can collide with the last two links
 	self_collision_checking = true;
 	gripper_length = gripper_length_;
 	ground_included = ground_included_;
@@ -109,135 +114,127 @@ std::shared_ptr<std::vector<KDL::Frame>> robots::xArm6::computeForwardKinematics
 	setConfiguration(q);
 
 	if (q->getFrames() != nullptr)		// It has been already computed!
+	{
+		cacheHit(q);
 		return q->getFrames();
+	}
 
-	KDL::TreeFkSolverPos_recursive tree_fk_solver(robot_tree);
-	std::vector<KDL::Frame> frames_fk(num_DOFs);
-	robot_tree.getChain("link_base", "link_eef", robot_chain);
-	KDL::JntArray joint_pos { KDL::JntArray(num_DOFs) };
+	std::shared_ptr<std::vector<KDL::Frame>> frames_fk { std::make_shared<std::vector<KDL::Frame>>(num_DOFs) };
+	computeForwardKinematics(q->getCoord(), *frames_fk);
+	
+	q->setFrames(frames_fk);
+	cacheMiss(q);
+	return frames_fk;
+}
+
+// Compute frames of all links for the configuration 'q_coord' into 'frames_fk', which must have 'num_DOFs' elements.
+// All frames are computed in a single forward pass by 'fk_solver', so no heap allocation occurs.
+void robots::xArm6::computeForwardKinematics(const Eigen::VectorXf &q_coord, std::vector<KDL::Frame> &frames_fk)
+{
+	fk_solver.compute(q_coord, frames_fk);
+	frames_fk.back().p += gripper_length * frames_fk.back().M.UnitZ();
+}
 
+// The same as 'computeForwardKinematics', but using KDL tree solver for each link separately.
+// It is kept as a reference for testing 'fk_solver'.
+void robots::xArm6::computeForwardKinematicsKDL(const Eigen::VectorXf &q_coord, std::vector<KDL::Frame> &frames_fk)
+{
 	for (size_t i = 0; i < num_DOFs; i++)
-		joint_pos(i) = q->getCoord(i);
+		joint_pos(i) = q_coord(i);
 
 	for (size_t i = 0; i < num_DOFs; i++)
 	{
-		KDL::Frame cart_pos {};
-		tree_fk_solver.JntToCart(joint_pos, cart_pos, robot_chain.getSegment(i).getName());
-		frames_fk[i] = cart_pos;
+		tree_fk_solver->JntToCart(joint_pos, frames_fk[i], robot_chain.getSegment(i).getName());
 		// std::cout << "Frame R" << i << ": " << frames_fk[i].M << "\n";
 		// std::cout << "Frame p" << i << ": " << frames_fk[i].p << "\n";
 	}
 	frames_fk.back().p += gripper_length * frames_fk.back().M.UnitZ();
-
-	q->setFrames(std::make_shared<std::vector<KDL::Frame>>(frames_fk));
-	return q->getFrames();
 }
 
 std::shared_ptr<base::State> robots::xArm6::computeInverseKinematics(const KDL::Rotation &R, const KDL::Vector &p, 
 																	 const std::shared_ptr<base::State> q_init)
 {
 	KDL::Vector p_new { p - gripper_length * R.UnitZ() };
-	robot_tree.getChain("link_base", "link_eef", robot_chain);
-	KDL::ChainFkSolverPos_recursive fk_solver(robot_chain);
-	KDL::ChainIkSolverVel_pinv ik_solver(robot_chain);
-	KDL::ChainIkSolverPos_NR ik_solver_pos(robot_chain, fk_solver, ik_solver, 1000, 1e-5);
-
-	KDL::JntArray q_in(num_DOFs);
-	KDL::JntArray q_out(num_DOFs);
-	KDL::Frame goal_frame(R, p_new);
-	Eigen::VectorXf q_result(num_DOFs);
-
-	float error { INFINITY };
-	size_t num { 0 };
-	while (error > 1e-5)
-	{
-		if (q_init == nullptr)
-		{
-			Eigen::VectorXf rand { Eigen::VectorXf::Random(num_DOFs) };
-			for (size_t i = 0; i < num_DOFs; i++)
-				q_in.data(i) = ((limits[i].second - limits[i].first) * rand(i) + limits[i].first + limits[i].second) / 2;
-		}
-		else
-		{
-			for (size_t i = 0; i < num_DOFs; i++)
-				q_in.data(i) = q_init->getCoord(i);
-		}
-
-		ik_solver_pos.CartToJnt(q_in, goal_frame, q_out);
-		error = ik_solver_pos.getError();
-		// std::cout << "error: " << error << std::endl;
-		for (size_t i = 0; i < num_DOFs; i++)
-		{
-			// Set the angle between -PI and PI
-			q_result(i) = q_out.data(i) - int(q_out.data(i) / (2*M_PI)) * 2*M_PI;
-			if (q_result(i) < -M_PI)
-				q_result(i) += 2*M_PI;
-			else if (q_result(i) > M_PI)
-				q_result(i) -= 2*M_PI;
-
-			if (q_result(i) > limits[i].second)
-			{
-				q_result(i) -= 2*M_PI;
-				if (q_result(i) < limits[i].first)
-				{
-					error = INFINITY; 	// Try to compute IK again.
-					break;
-				}
-			}
-			else if (q_result(i) < limits[i].first)
-			{
-				q_result(i) += 2*M_PI;
-				if (q_result(i) > limits[i].second)
-				{
-					error = INFINITY;	// Try to compute IK again.
-					break;
-				}
-			}
-		}
-
-		// std::cout << "num: " << num << std::endl;
-		if (num++ > 1000)
-		{
-			std::cout << "Unable to compute inverse kinematics for the given input frame! \n";
-			return nullptr;
-		}
-	}
-
-	return std::make_shared<base::RealVectorSpaceState>(q_result);
+	return solveInverseKinematics(robot_chain, KDL::Frame(R, p_new), q_init);
 }
 
 std::shared_ptr<Eigen::MatrixXf> robots::xArm6::computeSkeleton(const std::shared_ptr<base::State> q)
 {
 	if (q->getSkeleton() != nullptr)	// It has been already computed!
+	{
+		cacheHit(q);
 		return q->getSkeleton();
+	}
 	
 	std::shared_ptr<std::vector<KDL::Frame>> frames { computeForwardKinematics(q) };
 	std::shared_ptr<Eigen::MatrixXf> skeleton { std::make_shared<Eigen::MatrixXf>(3, num_DOFs + 1) };	// num_DOFs == getNumLinks() 
-	skeleton->col(0) << 0, 0, 0;
-	skeleton->col(1) << frames->at(1).p.x(), frames->at(1).p.y(), frames->at(1).p.z();
-	skeleton->col(2) << frames->at(2).p.x(), frames->at(2).p.y(), frames->at(2).p.z();
+	computeSkeleton(*frames, *skeleton);
+	
+	q->setSkeleton(skeleton);
+	cacheMiss(q);
+	return skeleton;
+}
 
-	// KDL::Vector p3 { frames->at(2).p + frames->at(2).M.UnitX() * 0.0775 };
-	KDL::Vector p3 { frames->at(3).p - frames->at(3).M.UnitZ() * 0.25 };
-	skeleton->col(3) << p3.x(), p3.y(), p3.z();
-	skeleton->col(4) << frames->at(4).p.x(), frames->at(4).p.y(), frames->at(4).p.z();
+// Compute skeleton for the configuration 'q_coord' without creating a state, i.e., frames and skeleton are not stored.
+// It is intended for configurations that are only checked (e.g., interpolated points along an edge).
+// If 'skeleton' is already of size 3 x (num_DOFs+1), no heap allocation occurs.
+void robots::xArm6::computeSkeleton(const Eigen::VectorXf &q_coord, Eigen::MatrixXf &skeleton)
+{
+	computeForwardKinematics(q_coord, frames_scratch);
+	skeleton.resize(3, num_DOFs + 1);
+	computeSkeleton(frames_scratch, skeleton);
+}
 
-	KDL::Vector p5 { frames->at(4).p + frames->at(4).M.UnitX() * 0.076 };
-	skeleton->col(5) << p5.x(), p5.y(), p5.z();
-	skeleton->col(6) << frames->at(5).p.x(), frames->at(5).p.y(), frames->at(5).p.z();
+void robots::xArm6::computeSkeleton(const std::vector<KDL::Frame> &frames, Eigen::MatrixXf &skeleton)
+{
+	skeleton.col(0) << 0, 0, 0;
+	skeleton.col(1) << frames[1].p.x(), frames[1].p.y(), frames[1].p.z();
+	skeleton.col(2) << frames[2].p.x(), frames[2].p.y(), frames[2].p.z();
+
+	// KDL::Vector p3 { frames[2].p + frames[2].M.UnitX() * 0.0775 };
+	KDL::Vector p3 { frames[3].p - frames[3].M.UnitZ() * 0.25 };
+	skeleton.col(3) << p3.x(), p3.y(), p3.z();
+	skeleton.col(4) << frames[4].p.x(), frames[4].p.y(), frames[4].p.z();
+
+	KDL::Vector p5 { frames[4].p + frames[4].M.UnitX() * 0.076 };
+	skeleton.col(5) << p5.x(), p5.y(), p5.z();
+	skeleton.col(6) << frames[5].p.x(), frames[5].p.y(), frames[5].p.z();
 
     // Correct the last skeleton point regarding the attached gripper.
-	KDL::Vector a { frames->back().M.UnitZ() };
-	skeleton->col(6) -= 0.3 * gripper_length * Eigen::Vector3f(a.x(), a.y(), a.z());	// Line (*)
-	
-	q->setSkeleton(skeleton);
-	return skeleton;
+	KDL::Vector a { frames.back().M.UnitZ() };
+	skeleton.col(6) -= 0.3 * gripper_length * Eigen::Vector3f(a.x(), a.y(), a.z());	// Line (*)
+}
+
+// Compute skeletons for a batch of configurations 'q_coords' at once (see 'AbstractRobot::computeSkeletons'), 
+// which gives the same result as 'computeSkeleton' for each configuration.
+// All frames are computed by 'fk_solver.computeBatch', and each skeleton row is computed for all configurations together.
+void robots::xArm6::computeSkeletons(const BatchSoA &q_coords, BatchSoA &skeletons)
+{
+	fk_solver.computeBatch(q_coords, frames_batch_scratch, num_DOFs);
+	skeletons.resize(3 * (num_DOFs + 1), q_coords.cols());
+	auto p = [&](size_t i, size_t r) { return frames_batch_scratch.row(12*i + 9 + r); };		// Translation of the frame i
+	auto x = [&](size_t i, size_t r) { return frames_batch_scratch.row(12*i + 3*r); };		// UnitX of the frame i
+	auto z = [&](size_t i, size_t r) { return frames_batch_scratch.row(12*i + 3*r + 2); };	// UnitZ of the frame i
+
+	for (size_t r = 0; r < 3; r++)
+	{
+		skeletons.row(r).setZero();
+		skeletons.row(3 + r) = p(1, r);
+		skeletons.row(6 + r) = p(2, r);
+		skeletons.row(9 + r) = p(3, r) - 0.25f * z(3, r);
+		skeletons.row(12 + r) = p(4, r);
+		skeletons.row(15 + r) = p(4, r) + 0.076f * x(4, r);
+		skeletons.row(18 + r) = p(5, r) + (1 - 0.3f) * gripper_length * z(5, r);	// Gripper offset from 'computeForwardKinematics' and Line (*)
+	}
 }
 
 std::shared_ptr<Eigen::MatrixXf> robots::xArm6::computeEnclosingRadii(const std::shared_ptr<base::State> q)
 {
 	if (q->getEnclosingRadii() != nullptr)	// It has been already computed!
+	{
+		cacheHit(q);
 		return q->getEnclosingRadii();
+	}
 
 	std::shared_ptr<Eigen::MatrixXf> skeleton { computeSkeleton(q) };
 	Eigen::MatrixXf R { Eigen::MatrixXf::Zero(num_DOFs, num_DOFs+1) };
@@ -271,158 +268,10 @@ std::shared_ptr<Eigen::MatrixXf> robots::xArm6::computeEnclosingRadii(const std:
 	}
 
 	q->setEnclosingRadii(std::make_shared<Eigen::MatrixXf>(R));
+	cacheMiss(q);
 	return q->getEnclosingRadii();
 }
 
-/// @brief Check if there exists a self-collision when the robot moves from 'q1' to 'q2' following a straight line in C-space.
-/// @param q1 Initial configuration
-/// @param q2 Final configuration
-/// @return True if there exists self-collision. Otherwise, return false.
-/// If there exists self-collision, 'q2' will be modified such that it is equal to a final reached configuration 
-/// from [q1,q2]-line that is collision-free.
-/// @note Because of joint limits, only first two links can collide with the last two links for xArm6 robot.
-bool robots::xArm6::checkSelfCollision(const std::shared_ptr<base::State> q1, std::shared_ptr<base::State> &q2)
-{
-	if (!self_collision_checking)
-		return false;
-	
-	// auto time_start { std::chrono::steady_clock::now() };
-	std::shared_ptr<base::State> q1_temp { q1 };
-	size_t num_iter { 0 };
-	size_t max_num_iter { 5 };
-	float phi2 {}, phi4 {}, phi5 {}, phi6 {};
-	float step04 {}, step05 {}, step14 {}, step15 {}, step {};
-	std::shared_ptr<Eigen::MatrixXf> R { nullptr };
-	Eigen::VectorXf delta_q {};
-
-	while (true)
-	{
-		R = computeEnclosingRadii(q1_temp);
-		delta_q = (q2->getCoord() - q1_temp->getCoord()).cwiseAbs();
-		phi2 = R->col(2).dot(delta_q); 	// Covered distance by skeleton point 2
-		phi4 = R->col(4).dot(delta_q);	// Covered distance by skeleton point 4
-		phi5 = R->col(5).dot(delta_q);	// Covered distance by skeleton point 5
-		phi6 = R->col(6).dot(delta_q);	// Covered distance by skeleton point 6
-
-		step04 = computeCapsulesDistance(q1_temp, 0, 4) / std::max(phi4, phi5);
-		step05 = computeCapsulesDistance(q1_temp, 0, 5) / std::max(phi5, phi6);
-		step14 = computeCapsulesDistance(q1_temp, 1, 4) / (phi2 + std::max(phi4, phi5));
-		step15 = computeCapsulesDistance(q1_temp, 1, 5) / (phi2 + std::max(phi5, phi6));
-		step = std::min(std::min(step04, step05), std::min(step14, step15));
-
-		if (step > 1)
-		{
-			// std::cout << "Self-collision surely does not occur! \n";
-			return false;
-		}
-
-		if (++num_iter == max_num_iter || step <= 0)
-			break;
-
-		if (step > 0)
-			q1_temp = std::make_shared<base::RealVectorSpaceState>(q1_temp->getCoord() + step * (q2->getCoord() - q1_temp->getCoord()));
-	}
-
-	Eigen::VectorXf q1_temp_coord { q1_temp->getCoord() };
-	Eigen::VectorXf q_new_coord {};
-	std::shared_ptr<base::State> q_new { nullptr };
-	base::State::Status status { base::State::Status::Advanced };
-	const float D { (q2->getCoord() - q1_temp_coord).norm() };
-	float dist { D };
-	float step_crit {};
-	std::vector<bool> skip_checking(4);
-	
-	while (status == base::State::Status::Advanced)
-	{
-		if (dist > RRTConnectConfig::EPS_STEP)
-			q_new_coord = q1_temp_coord + (q2->getCoord() - q1_temp_coord) / dist * RRTConnectConfig::EPS_STEP;
-		else
-		{
-			q_new_coord = q2->getCoord();
-			status = base::State::Status::Reached;
-		}
-
-		dist = (q2->getCoord() - q_new_coord).norm();
-		step_crit = 1 - dist / D;
-		skip_checking = { step05 > step_crit, 
-						  step15 > step_crit, 
-						  step04 > step_crit, 
-						  step14 > step_crit };
-		
-		q_new = std::make_shared<base::RealVectorSpaceState>(q_new_coord);
-		// std::cout << "Checking self-collision for q_new: " << q_new << "\n";
-		if (checkSelfCollision(q_new, skip_checking))
-		{
-			q2 = std::make_shared<base::RealVectorSpaceState>(q1_temp_coord);
-			// std::cout << "Self-collision occured! Setting q2 to: " << q2 << "\n";
-			return true;
-		}
-
-		q1_temp_coord = q_new_coord;
-	}
-
-	// std::cout << "No self-collision! \n";
-	// std::cout << "Elapsed time: " 
-	// 		  << std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - time_start).count() / 1e3 << " [us]\n\n";
-	return false;
-}
-
-/// @brief Check if there exists a self-collision when the xArm6 robot takes a configuration 'q'.
-/// @param q A configuration to be considered.
-/// @return True if there exists self-collision. Otherwise, return false.
-/// @note Because of joint limits, only first two links can collide with the last two links for xArm6 robot.
-bool robots::xArm6::checkSelfCollision(const std::shared_ptr<base::State> q)
-{
-	if (!self_collision_checking)
-		return false;
-		
-	std::vector<bool> skip_checking(4, false);
-	return checkSelfCollision(q, skip_checking);
-}
-
-/// @param skip_checking Determines whether collision checking between links: {0-5, 1-5, 0-4, 1-4} can be skipped.
-bool robots::xArm6::checkSelfCollision(const std::shared_ptr<base::State> q, std::vector<bool> &skip_checking)
-{
-	if (!skip_checking[0] && computeCapsulesDistance(q, 0, 5) < 0 && checkRealSelfCollision(q, 0, 5))
-	{
-		// std::cout << "Self-collision between link 0 and link 5 exists! \n";
-		return true;
-	}
-
-	if (!skip_checking[1] && computeCapsulesDistance(q, 1, 5) < 0 && checkRealSelfCollision(q, 1, 5))
-	{
-		// std::cout << "Self-collision between link 1 and link 5 exists! \n";
-		return true;
-	}
-	
-	if (!skip_checking[2] && computeCapsulesDistance(q, 0, 4) < 0 && checkRealSelfCollision(q, 0, 4))
-	{
-		// std::cout << "Self-collision between link 0 and link 4 exists! \n";
-		return true;
-	}
-
-	if (!skip_checking[3] && computeCapsulesDistance(q, 1, 4) < 0 && checkRealSelfCollision(q, 1, 4))
-	{
-		// std::cout << "Self-collision between link 1 and link 4 exists! \n";
-		return true;
-	}
-
-	return false;
-}
-
-/// @brief Compute distance between two corresponding capsules of 'link1_idx'-th and 'link2_idx'-th links for xArm6 robot.
-/// @param q Configuration of the robot
-/// @param link1_idx Index of the first link
-/// @param link2_idx Index of the second link
-float robots::xArm6::computeCapsulesDistance(const std::shared_ptr<base::State> q, size_t link1_idx, size_t link2_idx)
-{
-	std::shared_ptr<Eigen::MatrixXf> skeleton { computeSkeleton(q) };
-
-	return std::get<0>(base::RealVectorSpace::distanceLineSegToLineSeg
-		   (skeleton->col(link1_idx), skeleton->col(link1_idx+1), skeleton->col(link2_idx), skeleton->col(link2_idx+1))) 
-		   - getCapsuleRadius(link1_idx) - getCapsuleRadius(link2_idx);
-}
-
 bool robots::xArm6::checkRealSelfCollision(const std::shared_ptr<base::State> q, size_t link1_idx, size_t link2_idx)
 {
 	// std::cout << "Checking real self-collision between link " << link1_idx << " and link " << link2_idx << "... \n";
@@ -18,6 +18,10 @@ scenario::Scenario::Scenario(const std::string &config_file_path, const std::str
             robot = std::make_shared<robots::Planar2DOF>(root_path + robot_node["urdf"].as<std::string>());
         else if (type == "planar_10DOF")
             robot = std::make_shared<robots::Planar10DOF>(root_path + robot_node["urdf"].as<std::string>());
+        else if (type == "capsule_robot")
+            robot = std::make_shared<robots::CapsuleRobot>(root_path + robot_node["urdf"].as<std::string>(),
+                                                           root_path + robot_node["capsules"].as<std::string>(),
+                                                           robot_node["ground_included"].as<size_t>(0));
         else
             throw std::logic_error("Robot type is not correct!");
 
@@ -80,9 +84,9 @@ scenario::Scenario::Scenario(const std::string &config_file_path, const std::str
         std::shared_ptr<env::Environment> env {std::make_shared<env::Environment>(config_file_path, root_path) };
         std::string state_space { robot_node["space"].as<std::string>() };
         if (state_space == "RealVectorSpace")
-            ss = std::make_shared<base::RealVectorSpace>(num_DOFs, robot, env);
+            ss = createStateSpace<base::RealVectorSpace>(num_DOFs, robot, env);
         else if (state_space == "RealVectorSpaceFCL")
-            ss = std::make_shared<base::RealVectorSpaceFCL>(num_DOFs, robot, env);
+            ss = createStateSpace<base::RealVectorSpaceFCL>(num_DOFs, robot, env);
         else
             throw std::logic_error("State space does not exist!");
 
@@ -114,4 +118,23 @@ scenario::Scenario::Scenario(std::shared_ptr<base::StateSpace> ss_, std::shared_
     q_goal = q_goal_;
     state_space_type = ss->getStateSpaceType();
     num_dimensions = ss->num_dimensions;
+}
+
+// Create the state space of type 'Space'. For the supported numbers of DOFs (2, 6 and 10), 
+// its variant with the dimensionality known at compile time is created.
+template <class Space>
+std::shared_ptr<base::StateSpace> scenario::Scenario::createStateSpace(size_t num_DOFs, const std::shared_ptr<robots::AbstractRobot> robot, 
+                                                                       const std::shared_ptr<env::Environment> env)
+{
+    switch (num_DOFs)
+    {
+    case 2:
+        return std::make_shared<base::RealVectorSpaceN<2, Space>>(robot, env);
+    case 6:
+        return std::make_shared<base::RealVectorSpaceN<6, Space>>(robot, env);
+    case 10:
+        return std::make_shared<base::RealVectorSpaceN<10, Space>>(robot, env);
+    default:
+        return std::make_shared<Space>(num_DOFs, robot, env);
+    }
 }
\ No newline at end of file
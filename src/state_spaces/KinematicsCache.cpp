@@ -0,0 +1,117 @@
+#include "KinematicsCache.h"
+
+base::KinematicsCache::KinematicsCache(size_t max_size_)
+{
+	max_size = max_size_;
+	size = 0;
+	num_hits = 0;
+	num_misses = 0;
+	num_evictions = 0;
+}
+
+// States outliving the cache keep their quantities, and they are no longer tracked.
+base::KinematicsCache::~KinematicsCache()
+{
+	for (Entry &entry : entries)
+		entry.state->setKinematicsCache(nullptr);
+}
+
+// Record that a quantity of 'q' is used, which was already stored in 'q'.
+void base::KinematicsCache::hit(const std::shared_ptr<base::State> q)
+{
+	num_hits++;
+	update(q);
+}
+
+// Record that a quantity of 'q' is computed and stored in 'q'.
+// Quantities of the least recently used states are released if the total size exceeds 'max_size'.
+void base::KinematicsCache::miss(const std::shared_ptr<base::State> q)
+{
+	num_misses++;
+	update(q);
+	evict();
+}
+
+// Stop tracking 'q', which is called when 'q' is destroyed.
+void base::KinematicsCache::remove(const base::State *q)
+{
+	auto it { entry_indices.find(q) };
+	if (it == entry_indices.end())
+		return;
+
+	size -= it->second->size;
+	entries.erase(it->second);
+	entry_indices.erase(it);
+}
+
+// Release quantities of all tracked states.
+void base::KinematicsCache::clear()
+{
+	for (Entry &entry : entries)
+		release(entry.state);
+	
+	entries.clear();
+	entry_indices.clear();
+	size = 0;
+}
+
+// Move 'q' to the front of 'entries', and update the size of its quantities.
+void base::KinematicsCache::update(const std::shared_ptr<base::State> q)
+{
+	if (q->getKinematicsCache() != this)
+	{
+		if (q->getKinematicsCache() != nullptr)		// 'q' is tracked by another cache
+			q->getKinematicsCache()->remove(q.get());
+		
+		const size_t q_size { computeSize(q) };
+		entries.push_front(Entry{ q.get(), q_size });
+		entry_indices.emplace(q.get(), entries.begin());
+		q->setKinematicsCache(this);
+		size += q_size;
+		return;
+	}
+
+	std::list<Entry>::iterator entry { entry_indices.at(q.get()) };
+	const size_t q_size { computeSize(q) };
+	size += q_size - entry->size;
+	entry->size = q_size;
+	entries.splice(entries.begin(), entries, entry);
+}
+
+// Release quantities of the least recently used states until the total size does not exceed 'max_size'.
+// The most recently used state is never released, since its quantities are just being used.
+void base::KinematicsCache::evict()
+{
+	while (size > max_size && entries.size() > 1)
+	{
+		const Entry &entry { entries.back() };
+		release(entry.state);
+		num_evictions++;
+		size -= entry.size;
+		entry_indices.erase(entry.state);
+		entries.pop_back();
+	}
+}
+
+// Release quantities of 'q', which is no longer tracked.
+void base::KinematicsCache::release(base::State *q)
+{
+	q->setFrames(nullptr);
+	q->setSkeleton(nullptr);
+	q->setEnclosingRadii(nullptr);
+	q->setKinematicsCache(nullptr);
+}
+
+// Compute the size of quantities stored in 'q' in [B].
+size_t base::KinematicsCache::computeSize(const std::shared_ptr<base::State> q)
+{
+	size_t q_size { 0 };
+	if (q->getFrames() != nullptr)
+		q_size += sizeof(std::vector<KDL::Frame>) + q->getFrames()->capacity() * sizeof(KDL::Frame);
+	if (q->getSkeleton() != nullptr)
+		q_size += sizeof(Eigen::MatrixXf) + q->getSkeleton()->size() * sizeof(float);
+	if (q->getEnclosingRadii() != nullptr)
+		q_size += sizeof(Eigen::MatrixXf) + q->getEnclosingRadii()->size() * sizeof(float);
+	
+	return q_size;
+}
@@ -1,4 +1,5 @@
 #include "State.h"
+#include "KinematicsCache.h"
 
 base::State::State(const Eigen::VectorXf &coord_)
 {
@@ -18,7 +19,12 @@ base::State::State(const Eigen::VectorXf &coord_)
 	enclosing_radii = nullptr;
 }
 
-base::State::~State() {}
+// A state tracked by a kinematics cache is removed from it, so the cache never refers to a destroyed state
+base::State::~State() 
+{
+	if (kinematics_cache != nullptr)
+		kinematics_cache->remove(this);
+}
 
 void base::State::addChild(const std::shared_ptr<base::State> child)
 {
@@ -0,0 +1,59 @@
+#include "StatePool.h"
+
+base::StatePool::StatePool(size_t chunk_size_)
+{
+	chunk_size = chunk_size_;
+	block_size = 0;
+	next_block = nullptr;
+	chunk_end = nullptr;
+	free_blocks = nullptr;
+	num_blocks = 0;
+}
+
+base::StatePool::~StatePool()
+{
+	for (char *chunk : chunks)
+		::operator delete(chunk);
+}
+
+// Return a block of at least 'size' bytes. Larger requests than the first one are not served from the pool.
+void *base::StatePool::allocate(size_t size)
+{
+	if (block_size == 0)	// Blocks are aligned as memory returned by 'operator new'
+		block_size = (std::max(size, sizeof(void*)) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+	
+	if (size > block_size)
+		return ::operator new(size);
+	
+	num_blocks++;
+	if (free_blocks != nullptr)
+	{
+		void *block { free_blocks };
+		free_blocks = *static_cast<void**>(block);
+		return block;
+	}
+
+	if (next_block == chunk_end)
+	{
+		chunks.emplace_back(static_cast<char*>(::operator new(chunk_size * block_size)));
+		next_block = chunks.back();
+		chunk_end = next_block + chunk_size * block_size;
+	}
+	void *block { next_block };
+	next_block += block_size;
+	return block;
+}
+
+// Return the block 'ptr' of 'size' bytes to the pool
+void base::StatePool::deallocate(void *ptr, size_t size)
+{
+	if (size > block_size)
+	{
+		::operator delete(ptr);
+		return;
+	}
+
+	num_blocks--;
+	*static_cast<void**>(ptr) = free_blocks;
+	free_blocks = ptr;
+}
\ No newline at end of file
@@ -4,6 +4,7 @@ base::StateSpace::StateSpace()
 {
     robot = nullptr;
     env = nullptr;
+    state_pool = nullptr;
 }
 
 base::StateSpace::StateSpace(size_t num_dimensions_)
@@ -11,6 +12,7 @@ base::StateSpace::StateSpace(size_t num_dimensions_)
     num_dimensions = num_dimensions_;
     robot = nullptr;
     env = nullptr;
+    state_pool = nullptr;
 }
 
 base::StateSpace::StateSpace(size_t num_dimensions_, std::shared_ptr<robots::AbstractRobot> robot_, std::shared_ptr<env::Environment> env_)
@@ -18,6 +20,7 @@ base::StateSpace::StateSpace(size_t num_dimensions_, std::shared_ptr<robots::Abs
     num_dimensions = num_dimensions_;
     robot = robot_;
     env = env_;
+    state_pool = nullptr;
 }
 
 base::StateSpace::~StateSpace() {}
\ No newline at end of file
@@ -29,4 +29,24 @@ namespace base
 
 		return os;
 	}
+
+	std::ostream &operator<<(std::ostream &os, const base::EdgeCheckOrder &order) 
+	{
+		switch (order)
+		{
+			case base::EdgeCheckOrder::Backward:
+				os << "Backward";
+				break;
+
+			case base::EdgeCheckOrder::Forward:
+				os << "Forward";
+				break;
+
+			case base::EdgeCheckOrder::Bisection:
+				os << "Bisection";
+				break;
+		}
+
+		return os;
+	}
 }
\ No newline at end of file
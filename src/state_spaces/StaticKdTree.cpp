@@ -0,0 +1,10 @@
+#include "StaticKdTree.h"
+
+base::StaticKdTree::StaticKdTree(std::vector<float> &&coords_, size_t num_dimensions_)
+{
+	coords = std::move(coords_);
+	num_dimensions = num_dimensions_;
+	num_states = coords.size() / num_dimensions;
+	index = std::make_shared<base::StaticKdTreeIndex>(num_dimensions, *this, nanoflann::KDTreeSingleIndexAdaptorParams(10));
+	index->buildIndex();
+}
\ No newline at end of file
@@ -6,12 +6,32 @@ base::Tree::Tree(const std::string &tree_name_, size_t tree_idx_)
 	tree_idx = tree_idx_;
 	states = std::make_shared<std::vector<std::shared_ptr<base::State>>>();
 	kd_tree = nullptr;
+	contiguous_storage = TreeConfig::CONTIGUOUS_STORAGE;
+	num_dimensions = 0;
+	static_kd_tree = nullptr;
+	linear_search_threshold = TreeConfig::LINEAR_SEARCH_THRESHOLD;
+	approx_eps = 0;
 }
 
 base::Tree::Tree(const std::shared_ptr<std::vector<std::shared_ptr<base::State>>> states_)
 {
 	states = states_;
 	kd_tree = nullptr;
+	contiguous_storage = TreeConfig::CONTIGUOUS_STORAGE;
+	num_dimensions = 0;
+	static_kd_tree = nullptr;
+	linear_search_threshold = TreeConfig::LINEAR_SEARCH_THRESHOLD;
+	approx_eps = 0;
+	if (states->empty())
+		return;
+
+	num_dimensions = states->front()->getNumDimensions();
+	for (size_t i = 0; i < states->size(); i++)
+	{
+		if (contiguous_storage)
+			addToStorage(states->at(i));
+		addToIndex(i);
+	}
 }
 
 base::Tree::~Tree()
@@ -22,22 +42,74 @@ base::Tree::~Tree()
 void base::Tree::clearTree()
 {
 	states->clear();
+	kd_tree = nullptr;
+	static_kd_tree = nullptr;
+	linear_coords.resize(0, 0);
+	linear_dists_sqr.resize(0);
+	coords.clear();
+	parents.clear();
+}
+
+// Set the weight of each dimension used by the metric, which should be done before adding any node to the tree.
+// Empty 'metric_weights_' means that the Euclidean metric is used.
+void base::Tree::setMetricWeights(const Eigen::VectorXf &metric_weights_)
+{
+	metric_weights = metric_weights_;
+	metric_weights_sqr.resize(metric_weights.size());
+	for (long k = 0; k < metric_weights.size(); k++)
+		metric_weights_sqr[k] = metric_weights(k) * metric_weights(k);
+}
+
+// Append the data of 'q', which is already stored at 'states->at(q->getIdx())', to the contiguous arrays
+void base::Tree::addToStorage(const std::shared_ptr<base::State> q)
+{
+	if (num_dimensions == 0)
+		num_dimensions = q->getNumDimensions();
+
+	coords.insert(coords.end(), q->getCoord().data(), q->getCoord().data() + num_dimensions);
+	parents.emplace_back(-1);
+	refreshState(coords.size() / num_dimensions - 1);
+}
+
+// Copy the parent index of the state 'idx' to the contiguous arrays.
+// It should be called whenever the parent is changed after the state is added to the tree.
+// Costs and distances are not mirrored, since planners change them directly through the state.
+void base::Tree::refreshState(size_t idx)
+{
+	if (!contiguous_storage)
+		return;
+
+	const std::shared_ptr<base::State> q { states->at(idx) };
+	const std::shared_ptr<base::State> q_parent { q->getParent() };
+	if (isInTree(q_parent))
+		parents[idx] = q_parent->getIdx();
+	else
+		parents[idx] = -1;		// Parent does not belong to this tree
 }
 
+// Get nearest state to 'q'. If 'approx_eps' > 0, a state up to (1 + 'approx_eps') times farther than the nearest one may be returned.
 std::shared_ptr<base::State> base::Tree::getNearestState(const std::shared_ptr<base::State> q)
 {
+	if (kd_tree == nullptr && static_kd_tree == nullptr)
+	{
+		// Linear search, where squared distances to all nodes are accumulated dimension by dimension
+		const size_t N { states->size() };
+		Eigen::Index q_near_idx { 0 };
+		linear_dists_sqr.head(N).setZero();
+		for (size_t k = 0; k < num_dimensions; k++)
+			linear_dists_sqr.head(N) += (linear_coords.row(k).head(N) - getMetricWeight(k) * q->getCoord(k)).square();
+
+		linear_dists_sqr.head(N).minCoeff(&q_near_idx);
+		return getState(q_near_idx);
+	}
+
 	const size_t num_results { 1 };
 	size_t q_near_idx { 0 };
 	float out_dist_sqr { 0 };
 	nanoflann::KNNResultSet<float> result_set(num_results);
 	result_set.init(&q_near_idx, &out_dist_sqr);
 
-	Eigen::VectorXf v { q->getCoord() };
-	std::vector<float> vec(&v[0], v.data()+v.cols()*v.rows());
-
-	float *vec_c = &vec[0];
-	kd_tree->findNeighbors(result_set, vec_c, nanoflann::SearchParams(10));
-	vec_c = nullptr;
+	findNeighbors(result_set, q->getCoord().data(), approx_eps);
 	return getState(q_near_idx);
 }
 
@@ -46,6 +118,27 @@ std::shared_ptr<base::State> base::Tree::getNearestState2(const std::shared_ptr<
 {
 	size_t q_near_idx { 0 };
 	float d { 0 }, d_min { INFINITY };
+
+	if (contiguous_storage)
+	{
+		// Squared distances are compared, and the summation stops as soon as 'd_min' is exceeded
+		const float *q_coord { q->getCoord().data() };
+		const float *q_temp { coords.data() };
+		for (size_t i = 0; i < states->size(); i++, q_temp += num_dimensions)
+		{
+			d = 0;
+			for (size_t k = 0; k < num_dimensions && d < d_min; k++)
+				d += getMetricWeight(k) * getMetricWeight(k) * (q_temp[k] - q_coord[k]) * (q_temp[k] - q_coord[k]);
+			
+			if (d < d_min)
+			{
+				q_near_idx = i;
+				d_min = d;
+			}
+		}
+		return getState(q_near_idx);
+	}
+
 	bool is_out { false };
 	Eigen::VectorXf q_temp {};
 
@@ -55,7 +148,7 @@ std::shared_ptr<base::State> base::Tree::getNearestState2(const std::shared_ptr<
 		is_out = false;
 		for (size_t k = 0; k < q->getNumDimensions(); k++)
 		{
-			if (abs(q_temp(k) - q->getCoord(k)) > d_min)	// Is outside the box?
+			if (getMetricWeight(k) * abs(q_temp(k) - q->getCoord(k)) > d_min)	// Is outside the box?
 			{
 				is_out = true;
 				break;
@@ -63,7 +156,8 @@ std::shared_ptr<base::State> base::Tree::getNearestState2(const std::shared_ptr<
 		}
 		if (!is_out)	// Is inside the box?
 		{
-			d = (q_temp - q->getCoord()).norm();
+			d = metric_weights.size() == 0 ? (q_temp - q->getCoord()).norm() : 
+											   (q_temp - q->getCoord()).cwiseProduct(metric_weights).norm();
 			if (d < d_min)
 			{
 				q_near_idx = i;
@@ -74,18 +168,175 @@ std::shared_ptr<base::State> base::Tree::getNearestState2(const std::shared_ptr<
 	return getState(q_near_idx);
 }
 
+/// @brief Get 'k' nearest states to each state from 'qs' in a single call.
+/// @param qs Query states.
+/// @param k Number of nearest states per query.
+/// @param parallel If true, queries are divided among all available hardware threads. Default: false.
+/// @return For each query, at most 'k' nearest states sorted by their distance to the query.
+std::vector<std::vector<std::shared_ptr<base::State>>> base::Tree::getKNearestStates
+	(const std::vector<std::shared_ptr<base::State>> &qs, size_t k, bool parallel) const
+{
+	std::vector<std::vector<std::shared_ptr<base::State>>> q_nearest(qs.size());
+	runQueries(qs.size(), [&](size_t begin, size_t end)
+	{
+		std::vector<size_t> q_near_idx(k);
+		std::vector<float> out_dist_sqr(k);
+		for (size_t i = begin; i < end; i++)
+		{
+			nanoflann::KNNResultSet<float> result_set(k);
+			result_set.init(q_near_idx.data(), out_dist_sqr.data());
+			findNeighbors(result_set, qs[i]->getCoord().data());
+			
+			q_nearest[i].reserve(result_set.size());
+			for (size_t j = 0; j < result_set.size(); j++)
+				q_nearest[i].emplace_back(getState(q_near_idx[j]));
+		}
+	}, parallel);
+
+	return q_nearest;
+}
+
+/// @brief Get all states within the radius 'r' from each state from 'qs' in a single call.
+/// @param qs Query states.
+/// @param r Radius.
+/// @param parallel If true, queries are divided among all available hardware threads. Default: false.
+/// @return For each query, all states within the radius 'r' sorted by their distance to the query.
+std::vector<std::vector<std::shared_ptr<base::State>>> base::Tree::getStatesWithinRadius
+	(const std::vector<std::shared_ptr<base::State>> &qs, float r, bool parallel) const
+{
+	std::vector<std::vector<std::shared_ptr<base::State>>> q_within(qs.size());
+	runQueries(qs.size(), [&](size_t begin, size_t end)
+	{
+		std::vector<std::pair<size_t, float>> indices_dists {};
+		for (size_t i = begin; i < end; i++)
+		{
+			indices_dists.clear();
+			nanoflann::RadiusResultSet<float> result_set(r * r, indices_dists);	// Squared distances are used
+			findNeighbors(result_set, qs[i]->getCoord().data());
+			std::sort(indices_dists.begin(), indices_dists.end(), 
+					  [](const std::pair<size_t, float> &a, const std::pair<size_t, float> &b) { return a.second < b.second; });
+
+			q_within[i].reserve(indices_dists.size());
+			for (const std::pair<size_t, float> &idx_dist : indices_dists)
+				q_within[i].emplace_back(getState(idx_dist.first));
+		}
+	}, parallel);
+
+	return q_within;
+}
+
+// Call 'run_range(begin, end)' for consecutive ranges of queries that cover all 'num_queries' queries.
+// If 'parallel' is true, each range is processed in its own thread.
+void base::Tree::runQueries(size_t num_queries, const std::function<void(size_t, size_t)> &run_range, bool parallel)
+{
+	size_t num_threads { parallel ? std::min<size_t>(std::thread::hardware_concurrency(), num_queries) : 1 };
+	if (num_threads <= 1)
+	{
+		run_range(0, num_queries);
+		return;
+	}
+
+	std::vector<std::thread> threads {};
+	size_t range { (num_queries + num_threads - 1) / num_threads };
+	for (size_t begin = 0; begin < num_queries; begin += range)
+		threads.emplace_back(run_range, begin, std::min(begin + range, num_queries));
+	
+	for (std::thread &thread : threads)
+		thread.join();
+}
+
 // 'q_new' - new state added to tree
 // 'q_parent' - parent of 'q_new'
 void base::Tree::upgradeTree(const std::shared_ptr<base::State> q_new, const std::shared_ptr<base::State> q_parent)
 {
 	size_t N { states->size() };
 	states->emplace_back(q_new);
-	kd_tree->addPoints(N, N); 	// Comment this line if you are not using Kd-Trees
+	if (num_dimensions == 0)
+		num_dimensions = q_new->getNumDimensions();
 	q_new->setTreeIdx(getTreeIdx());
 	q_new->setIdx(N);
 	q_new->setParent(q_parent);
 	if (q_parent != nullptr)
 		q_parent->addChild(q_new);
+	
+	if (contiguous_storage)
+		addToStorage(q_new);
+	
+	addToIndex(N);
+	updateStaticKdTree();
+}
+
+// Make the node 'idx' (the last added one) searchable. The Kd-tree is built when the number of nodes exceeds 'linear_search_threshold'.
+// Afterwards, the node is added to the Kd-tree, unless the static Kd-tree is used, when it is searched linearly until the rebuild.
+void base::Tree::addToIndex(size_t idx)
+{
+	if (kd_tree != nullptr)
+		kd_tree->addPoints(idx, idx);
+	else if (static_kd_tree != nullptr)
+		return;
+	else if (idx < linear_search_threshold)
+	{
+		if (linear_coords.cols() == 0)
+		{
+			linear_coords.resize(num_dimensions, linear_search_threshold);
+			linear_dists_sqr.resize(linear_search_threshold);
+		}
+		for (size_t k = 0; k < num_dimensions; k++)
+			linear_coords(k, idx) = getMetricWeight(k) * getCoordData(idx)[k];
+	}
+	else
+	{
+		kd_tree = std::make_shared<base::KdTree>(num_dimensions, *this, nanoflann::KDTreeSingleIndexAdaptorParams(10));
+		kd_tree->addPoints(0, idx);
+		linear_coords.resize(0, 0);
+		linear_dists_sqr.resize(0);
+	}
+}
+
+// Start rebuilding the static Kd-tree in the background when the tree has more than 'TreeConfig::STATIC_KD_TREE_THRESHOLD' nodes 
+// and more than 'TreeConfig::KD_TREE_BUFFER_SIZE' nodes are not contained in the static Kd-tree. 
+// When the rebuilt Kd-tree is ready, it replaces the previous one (and the dynamic Kd-tree).
+void base::Tree::updateStaticKdTree()
+{
+	if (TreeConfig::STATIC_KD_TREE_THRESHOLD == 0 || states->size() < TreeConfig::STATIC_KD_TREE_THRESHOLD)
+		return;
+
+	if (static_kd_tree_next.valid())
+	{
+		if (static_kd_tree_next.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			return;
+		
+		takeStaticKdTree();
+	}
+
+	if (static_kd_tree == nullptr || states->size() - static_kd_tree->getNumStates() > TreeConfig::KD_TREE_BUFFER_SIZE)
+	{
+		// Coordinates are copied, since the tree storage may be reallocated while the Kd-tree is being built
+		std::vector<float> coords_copy(states->size() * num_dimensions);
+		for (size_t i = 0; i < states->size(); i++)
+		{
+			for (size_t k = 0; k < num_dimensions; k++)	// The static Kd-tree uses the Euclidean metric on weighted coordinates
+				coords_copy[i * num_dimensions + k] = getMetricWeight(k) * getCoordData(i)[k];
+		}
+		
+		static_kd_tree_next = std::async(std::launch::async, [coords_copy = std::move(coords_copy), dim = num_dimensions]() mutable 
+			{ return std::make_shared<base::StaticKdTree>(std::move(coords_copy), dim); });
+	}
+}
+
+// Replace the static Kd-tree (and the dynamic Kd-tree) with the rebuilt one
+void base::Tree::takeStaticKdTree()
+{
+	static_kd_tree = static_kd_tree_next.get();
+	static_kd_tree_next = std::shared_future<std::shared_ptr<base::StaticKdTree>>();
+	kd_tree = nullptr;	// Not needed anymore
+}
+
+// Block until the static Kd-tree, which is being rebuilt in the background (if any), is ready, and then use it
+void base::Tree::waitForRebuild()
+{
+	if (static_kd_tree_next.valid())
+		takeStaticKdTree();
 }
 
 // 'q_new' - new state added to tree
@@ -99,6 +350,25 @@ void base::Tree::upgradeTree(const std::shared_ptr<base::State> q_new, const std
 	q_new->setDistanceProfile(q_ref->getDistanceProfile());
 	q_new->setIsRealDistance(q_ref->getIsRealDistance());
 	q_new->setNearestPoints(q_ref->getNearestPoints());
+	refreshState(q_new->getIdx());
+}
+
+// Return all states from the state 'idx' to the root of the tree.
+// In both storage modes, the path ends at the first state whose parent does not belong to this tree (see 'isInTree').
+std::vector<std::shared_ptr<base::State>> base::Tree::computePathToRoot(size_t idx) const
+{
+	std::vector<std::shared_ptr<base::State>> path {};
+	if (contiguous_storage)
+	{
+		for (long i = idx; i != -1; i = parents[i])
+			path.emplace_back(states->at(i));
+	}
+	else
+	{
+		for (std::shared_ptr<base::State> q = states->at(idx); q != nullptr; q = isInTree(q->getParent()) ? q->getParent() : nullptr)
+			path.emplace_back(q);
+	}
+	return path;
 }
 
 namespace base 
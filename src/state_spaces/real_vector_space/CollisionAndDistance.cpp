@@ -41,10 +41,74 @@ bool base::CollisionAndDistance::collisionCapsuleToBox(const Eigen::Vector3f &A,
     return collision;
 }
 
+// Check collision between capsule (determined with line segment AB and 'radius') and all boxes from 'boxes' starting at the column 'first'.
+// Boxes are processed in blocks of 16, such that the quick tests from 'collisionCapsuleToBox' (whether A or B is inside the box,
+// or the capsule is on the outer side of some box face) are vectorised. Only boxes that are not decided by these tests, 
+// and boxes from the last incomplete block, are checked using 'collisionCapsuleToBox'. Thus, the result is always the same.
+bool base::CollisionAndDistance::collisionCapsuleToBoxes(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, 
+														 const BoxesSoA &boxes, size_t first)
+{
+	typedef Eigen::Array<float, 1, 16> Block;
+	const size_t block_size { 16 };
+	const float r_new = radius * sqrt(3) / 3;
+	const Eigen::Vector3f AB_min { A.cwiseMin(B) };
+	const Eigen::Vector3f AB_max { A.cwiseMax(B) };
+	static thread_local Eigen::VectorXf obs(6);
+	Block inside_A {}, inside_B {}, separated {};
+	size_t j { first };
+
+	for (; j + block_size <= size_t(boxes.cols()); j += block_size)
+	{
+		// Negative value means that the point is inside the box enlarged by 'r_new'
+		inside_A = (boxes.row(0).segment<block_size>(j) - r_new) - A(0);
+		inside_B = (boxes.row(0).segment<block_size>(j) - r_new) - B(0);
+		for (size_t k = 0; k < 3; k++)
+		{
+			if (k > 0)
+			{
+				inside_A = inside_A.max((boxes.row(k).segment<block_size>(j) - r_new) - A(k));
+				inside_B = inside_B.max((boxes.row(k).segment<block_size>(j) - r_new) - B(k));
+			}
+			inside_A = inside_A.max(A(k) - (boxes.row(k+3).segment<block_size>(j) + r_new));
+			inside_B = inside_B.max(B(k) - (boxes.row(k+3).segment<block_size>(j) + r_new));
+		}
+		if (inside_A.min(inside_B).minCoeff() < 0)
+			return true;
+		
+		// Positive value means that the segment AB is on the outer side of some face of the box enlarged by 'radius'
+		separated = (boxes.row(0).segment<block_size>(j) - radius) - AB_max(0);
+		for (size_t k = 0; k < 3; k++)
+		{
+			if (k > 0)
+				separated = separated.max((boxes.row(k).segment<block_size>(j) - radius) - AB_max(k));
+			separated = separated.max(AB_min(k) - (boxes.row(k+3).segment<block_size>(j) + radius));
+		}
+
+		for (size_t k = 0; k < block_size; k++)
+		{
+			if (separated(k) > 0)
+				continue;
+			
+			obs = boxes.col(j + k);
+			if (collisionCapsuleToBox(A, B, radius, obs))
+				return true;
+		}
+	}
+
+	for (; j < size_t(boxes.cols()); j++)
+	{
+		obs = boxes.col(j);
+		if (collisionCapsuleToBox(A, B, radius, obs))
+			return true;
+	}
+
+	return false;
+}
+
 // Check collision between capsule (determined with line segment AB and 'radius') and rectangle (determined with 'obs',
 // where 'coord' determines which coordinate is constant: {0,1,2,3,4,5} = {x_min, y_min, z_min, x_max, y_max, z_max}
 bool base::CollisionAndDistance::collisionCapsuleToRectangle(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, 
-															 Eigen::VectorXf &obs, size_t coord)
+															 const Eigen::VectorXf &obs, size_t coord)
 {
 	float obs_coord { obs(coord) };
     if (coord > 2) {
@@ -117,31 +181,32 @@ float base::CollisionAndDistance::checkCases(const Eigen::Vector3f &A, const Eig
 	float d_c2 { INFINITY };
 	Eigen::Vector3f C {};
 	Eigen::Vector3f D {};
+	NearestPoints nearest_pts {};
 	
 	if (point(0) < rec(0))
 	{
 		C = get3DPoint(Eigen::Vector2f(rec(0), rec(1)), obs_coord, coord);
 		D = get3DPoint(Eigen::Vector2f(rec(0), rec(3)), obs_coord, coord);
-		d_c1 = std::get<0>(distanceLineSegToLineSeg(A, B, C, D));
+		d_c1 = distanceLineSegToLineSeg(A, B, C, D, nearest_pts);
 	}
 	else if (point(0) > rec(2))
 	{
 		C = get3DPoint(Eigen::Vector2f(rec(2), rec(1)), obs_coord, coord);
 		D = get3DPoint(Eigen::Vector2f(rec(2), rec(3)), obs_coord, coord);
-		d_c1 = std::get<0>(distanceLineSegToLineSeg(A, B, C, D));
+		d_c1 = distanceLineSegToLineSeg(A, B, C, D, nearest_pts);
 	}
 	
 	if (d_c1 > 0 && point(1) < rec(1))
 	{
 		C = get3DPoint(Eigen::Vector2f(rec(0), rec(1)), obs_coord, coord);
 		D = get3DPoint(Eigen::Vector2f(rec(2), rec(1)), obs_coord, coord);
-		d_c2 = std::get<0>(distanceLineSegToLineSeg(A, B, C, D));
+		d_c2 = distanceLineSegToLineSeg(A, B, C, D, nearest_pts);
 	}
 	else if (d_c1 > 0 && point(1) > rec(3))
 	{
 		C = get3DPoint(Eigen::Vector2f(rec(0), rec(3)), obs_coord, coord);
 		D = get3DPoint(Eigen::Vector2f(rec(2), rec(3)), obs_coord, coord);
-		d_c2 = std::get<0>(distanceLineSegToLineSeg(A, B, C, D));
+		d_c2 = distanceLineSegToLineSeg(A, B, C, D, nearest_pts);
 	}
 
 	return std::min(d_c1, d_c2);
@@ -179,7 +244,7 @@ bool base::CollisionAndDistance::collisionLineSegToLineSeg(const Eigen::Vector3f
 }
 
 // Check collision between capsule (determined with line segment AB and 'radius') and sphere (determined with 'obs = (x_c, y_c, z_c, r)')
-bool base::CollisionAndDistance::collisionCapsuleToSphere(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, Eigen::VectorXf &obs)
+bool base::CollisionAndDistance::collisionCapsuleToSphere(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, const Eigen::VectorXf &obs)
 {
 	radius += obs(3);
     if ((A - obs.head(3)).norm() < radius || (B - obs.head(3)).norm() < radius)
@@ -203,23 +268,86 @@ bool base::CollisionAndDistance::collisionCapsuleToSphere(const Eigen::Vector3f
     return false;
 }
 
+// Check collision between capsule (determined with line segment AB and 'radius') and oriented box, which is determined with 
+// its rotation 'R', its center 'center', and 'obs = (-h_x, -h_y, -h_z, h_x, h_y, h_z)' in its own frame ('h' are half-dimensions).
+// The capsule is transformed into the box frame, where the box is axis-aligned.
+bool base::CollisionAndDistance::collisionCapsuleToOrientedBox(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, 
+	const Eigen::Matrix3f &R, const Eigen::Vector3f &center, Eigen::VectorXf &obs)
+{
+	return collisionCapsuleToBox(R.transpose() * (A - center), R.transpose() * (B - center), radius, obs);
+}
+
 // Get distance (and nearest points) between capsule (determined with line segment AB and 'radius') 
 // and box (determined with 'obs = (x_min, y_min, z_min, x_max, y_max, z_max)')
 std::tuple<float, std::shared_ptr<Eigen::MatrixXf>> base::CollisionAndDistance::distanceCapsuleToBox
 	(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, Eigen::VectorXf &obs)
+{
+	NearestPoints nearest_pts {};
+	float d_c { distanceCapsuleToBox(A, B, radius, obs, nearest_pts) };
+	return {d_c, d_c > 0 ? std::make_shared<Eigen::MatrixXf>(nearest_pts) : nullptr};
+}
+
+// Get distance between capsule (determined with line segment AB and 'radius') and box (determined with 
+// 'obs = (x_min, y_min, z_min, x_max, y_max, z_max)'), while nearest points are stored into 'nearest_pts'
+float base::CollisionAndDistance::distanceCapsuleToBox
+	(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, const Eigen::VectorXf &obs, NearestPoints &nearest_pts)
 {
 	CapsuleToBox capsule_box(A, B, radius, obs);
 	capsule_box.compute();
-	return {capsule_box.getDistance(), capsule_box.getNearestPoints()};
+	nearest_pts = capsule_box.getNearestPoints();
+	return capsule_box.getDistance();
+}
+
+// Get lower bound on distance between capsule (determined with line segment AB and 'radius') and box 'obs', 
+// computed as distance between AABB of the line segment AB and the box, decreased by 'radius'.
+// 'plane_pts' (3x2 matrix) contains points 'R' and 'O', such that the plane through 'O' with normal 'R - O' separates
+// the box from the capsule's AABB. Thus, they can be used instead of nearest points when underestimating distance.
+// If the returned value is not positive, 'plane_pts' is not valid.
+float base::CollisionAndDistance::distanceCapsuleToBoxLowerBound
+	(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, const Eigen::VectorXf &obs, NearestPoints &plane_pts)
+{
+	const Eigen::Vector3f AB_min { A.cwiseMin(B) };
+	const Eigen::Vector3f AB_max { A.cwiseMax(B) };
+	float d_sqr { 0 };
+
+	for (size_t k = 0; k < 3; k++)
+	{
+		if (AB_max(k) < obs(k))				// Capsule is below the box
+		{
+			plane_pts(k, 1) = obs(k);
+			plane_pts(k, 0) = AB_max(k);
+		}
+		else if (AB_min(k) > obs(k+3))		// Capsule is above the box
+		{
+			plane_pts(k, 1) = obs(k+3);
+			plane_pts(k, 0) = AB_min(k);
+		}
+		else
+		{
+			plane_pts(k, 1) = std::clamp((AB_min(k) + AB_max(k)) / 2, obs(k), obs(k+3));
+			plane_pts(k, 0) = plane_pts(k, 1);
+		}
+		d_sqr += (plane_pts(k, 0) - plane_pts(k, 1)) * (plane_pts(k, 0) - plane_pts(k, 1));
+	}
+
+	return std::sqrt(d_sqr) - radius;
 }
 
 // Get distance (and nearest points) between two line segments, AB and CD
 std::tuple<float, std::shared_ptr<Eigen::MatrixXf>> base::CollisionAndDistance::distanceLineSegToLineSeg
 	(const Eigen::Vector3f &A, const Eigen::Vector3f &B, const Eigen::Vector3f &C, const Eigen::Vector3f &D)
+{
+	NearestPoints nearest_pts {};
+	float d_c { distanceLineSegToLineSeg(A, B, C, D, nearest_pts) };
+	return {d_c, d_c > 0 ? std::make_shared<Eigen::MatrixXf>(nearest_pts) : nullptr};
+}
+
+// Get distance between two line segments, AB and CD, while nearest points are stored into 'nearest_pts'
+float base::CollisionAndDistance::distanceLineSegToLineSeg
+	(const Eigen::Vector3f &A, const Eigen::Vector3f &B, const Eigen::Vector3f &C, const Eigen::Vector3f &D, NearestPoints &nearest_pts)
 {
     float d_c { INFINITY };
-    std::shared_ptr<Eigen::MatrixXf> nearest_pts { std::make_shared<Eigen::MatrixXf>(3, 2) };
-    std::shared_ptr<Eigen::MatrixXf> nearest_pts_temp { std::make_shared<Eigen::MatrixXf>(3, 2) };
+    NearestPoints nearest_pts_temp {};
     float alpha1 { (B - A).squaredNorm() };
     float alpha2 { (B - A).dot(D - C) };
     float beta1  { (C - D).dot(B - A) };
@@ -231,11 +359,11 @@ std::tuple<float, std::shared_ptr<Eigen::MatrixXf>> base::CollisionAndDistance::
 	
 	if (t > 0 && t < 1 && s > 0 && s < 1)
 	{
-        nearest_pts->col(0) = A + t * (B - A);
-        nearest_pts->col(1) = C + s * (D - C);
-		d_c = (nearest_pts->col(1) - nearest_pts->col(0)).norm();
+        nearest_pts.col(0) = A + t * (B - A);
+        nearest_pts.col(1) = C + s * (D - C);
+		d_c = (nearest_pts.col(1) - nearest_pts.col(0)).norm();
         if (d_c < RealVectorSpaceConfig::EQUALITY_THRESHOLD) 	// The collision occurs
-            return {0, nullptr};
+            return 0;
     }
     else
 	{
@@ -252,93 +380,101 @@ std::tuple<float, std::shared_ptr<Eigen::MatrixXf>> base::CollisionAndDistance::
 			{
 				if (i == 0 || i == 2)     	// s = 0, t = 0
 				{
-					nearest_pts_temp->col(0) = A;
-					nearest_pts_temp->col(1) = C; 
+					nearest_pts_temp.col(0) = A;
+					nearest_pts_temp.col(1) = C; 
 				}
                 else if (i == 1)      		// s = 1, t = 0
 				{
-					nearest_pts_temp->col(0) = A;
-                    nearest_pts_temp->col(1) = D; 
+					nearest_pts_temp.col(0) = A;
+                    nearest_pts_temp.col(1) = D; 
 				}
                 else                      	// t = 1, s = 0
 				{
-					nearest_pts_temp->col(0) = B;
-                    nearest_pts_temp->col(1) = C; 
+					nearest_pts_temp.col(0) = B;
+                    nearest_pts_temp.col(1) = C; 
 				}
 			}
             else if (opt(i) > 1)
 			{
 				if (i == 1 || i == 3)    	// s = 1, t = 1
 				{
-					nearest_pts_temp->col(0) = B;
-					nearest_pts_temp->col(1) = D; 
+					nearest_pts_temp.col(0) = B;
+					nearest_pts_temp.col(1) = D; 
 				}
                 else if (i == 0)        	// s = 0, t = 1
 				{
-					nearest_pts_temp->col(0) = B;
-					nearest_pts_temp->col(1) = C; 
+					nearest_pts_temp.col(0) = B;
+					nearest_pts_temp.col(1) = C; 
 				}                    
                 else                    	// t = 0, s = 1
 				{
-					nearest_pts_temp->col(0) = A;
-					nearest_pts_temp->col(1) = D; 
+					nearest_pts_temp.col(0) = A;
+					nearest_pts_temp.col(1) = D; 
 				}
 			}
             else
 			{
 				if (i == 0)                	// s = 0, t € [0, 1]
 				{
-					nearest_pts_temp->col(0) = A + opt(i) * (B - A);
-					nearest_pts_temp->col(1) = C; 
+					nearest_pts_temp.col(0) = A + opt(i) * (B - A);
+					nearest_pts_temp.col(1) = C; 
 				}                    
                 else if (i == 1)       		// s = 1, t € [0, 1]
 				{
-					nearest_pts_temp->col(0) = A + opt(i) * (B - A);
-                    nearest_pts_temp->col(1) = D; 
+					nearest_pts_temp.col(0) = A + opt(i) * (B - A);
+                    nearest_pts_temp.col(1) = D; 
 				}
                 else if (i == 2)           	// t = 0, s € [0, 1]
 				{
-					nearest_pts_temp->col(0) = A;
-                    nearest_pts_temp->col(1) = C + opt(i) * (D - C); 
+					nearest_pts_temp.col(0) = A;
+                    nearest_pts_temp.col(1) = C + opt(i) * (D - C); 
 				}
                 else                       	// t = 1, s € [0, 1]
 				{
-					nearest_pts_temp->col(0) = B;
-                    nearest_pts_temp->col(1) = C + opt(i) * (D - C); 
+					nearest_pts_temp.col(0) = B;
+                    nearest_pts_temp.col(1) = C + opt(i) * (D - C); 
 				}
 			}
             
-            d_c_temp = (nearest_pts_temp->col(1) - nearest_pts_temp->col(0)).norm();
+            d_c_temp = (nearest_pts_temp.col(1) - nearest_pts_temp.col(0)).norm();
             if (d_c_temp < d_c)
 			{
                 d_c = d_c_temp;
-				*nearest_pts = *nearest_pts_temp;
+				nearest_pts = nearest_pts_temp;
 			}
         }
     }
-	return {d_c, nearest_pts};
+	return d_c;
 }
 
 // Get distance (and nearest points) between line segment AB and point C
 std::tuple<float, std::shared_ptr<Eigen::MatrixXf>> base::CollisionAndDistance::distanceLineSegToPoint
 	(const Eigen::Vector3f &A, const Eigen::Vector3f &B, const Eigen::Vector3f &C)
 {
-    std::shared_ptr<Eigen::MatrixXf> nearest_pts { std::make_shared<Eigen::MatrixXf>(3, 2) };
-    nearest_pts->col(1) = C;
+	NearestPoints nearest_pts {};
+	float d_c { distanceLineSegToPoint(A, B, C, nearest_pts) };
+	return {d_c, d_c > 0 ? std::make_shared<Eigen::MatrixXf>(nearest_pts) : nullptr};
+}
+
+// Get distance between line segment AB and point C, while nearest points are stored into 'nearest_pts'
+float base::CollisionAndDistance::distanceLineSegToPoint
+	(const Eigen::Vector3f &A, const Eigen::Vector3f &B, const Eigen::Vector3f &C, NearestPoints &nearest_pts)
+{
+    nearest_pts.col(1) = C;
     float t_opt { (C - A).dot(B - A) / (B - A).squaredNorm() };
 
     if (t_opt < 0)
-		nearest_pts->col(0) = A;
+		nearest_pts.col(0) = A;
     else if (t_opt > 1)
-        nearest_pts->col(0) = B;
+        nearest_pts.col(0) = B;
     else
-		nearest_pts->col(0) = A + t_opt * (B - A);
+		nearest_pts.col(0) = A + t_opt * (B - A);
 	
-	float d_c { (nearest_pts->col(1) - nearest_pts->col(0)).norm() };
+	float d_c { (nearest_pts.col(1) - nearest_pts.col(0)).norm() };
 	if (d_c < RealVectorSpaceConfig::EQUALITY_THRESHOLD)
-		return {0, nullptr};
+		return 0;
 
-	return {d_c, nearest_pts};
+	return d_c;
 }
 
 // Get distance (and nearest points) between capsule (determined with line segment AB and 'radius') 
@@ -346,63 +482,56 @@ std::tuple<float, std::shared_ptr<Eigen::MatrixXf>> base::CollisionAndDistance::
 std::tuple<float, std::shared_ptr<Eigen::MatrixXf>> base::CollisionAndDistance::distanceCapsuleToSphere
 	(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, Eigen::VectorXf &obs)
 {
-    std::shared_ptr<Eigen::MatrixXf> nearest_pts { std::make_shared<Eigen::MatrixXf>(3, 2) };
-	float AO { (A - obs.head(3)).norm() };
-    float d_c { AO - obs(3) };
-    if (d_c < radius)	// The collision occurs
-        return {0, nullptr};
-    
-    float BO { (B - obs.head(3)).norm() };
-    float d_c_temp { BO - obs(3) };
-    if (d_c_temp < radius) 	// The collision occurs
-        return {0, nullptr};
-    
-    if (d_c_temp < d_c)
-        d_c = d_c_temp; 
+	NearestPoints nearest_pts {};
+	float d_c { distanceCapsuleToSphere(A, B, radius, obs, nearest_pts) };
+	return {d_c, d_c > 0 ? std::make_shared<Eigen::MatrixXf>(nearest_pts) : nullptr};
+}
 
-    float AB { (A - B).norm() };
-    float s { (AB + AO + BO) / 2 };
-    float alpha = acos((AO * AO + AB * AB - BO * BO) / (2 * AO * AB));
-    d_c_temp = 2 * sqrt(s * (s - AB) * (s - AO) * (s - BO)) / AB - obs(3);     // h = 2 * P / AB; d_c_temp = h - obs(3);
+// Get distance between capsule (determined with line segment AB and 'radius') and sphere (determined with 
+// 'obs = (x_c, y_c, z_c, r)'), while nearest points are stored into 'nearest_pts'
+float base::CollisionAndDistance::distanceCapsuleToSphere
+	(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, const Eigen::VectorXf &obs, NearestPoints &nearest_pts)
+{
+	const Eigen::Vector3f AB { B - A };
+	const Eigen::Vector3f O { obs.head(3) };
+	const float AB_sqr { AB.squaredNorm() };
+	const float t { AB_sqr > 0 ? std::clamp((O - A).dot(AB) / AB_sqr, 0.f, 1.f) : 0.f };
+	const Eigen::Vector3f P { A + t * AB };		// Nearest point of AB to the sphere center
+	const float PO { (O - P).norm() };
+	
+	float d_c { PO - obs(3) - radius };
+	if (d_c <= 0)	// The collision occurs
+		return 0;
 
-    if (alpha < M_PI / 2)
-	{
-        float beta = acos((BO * BO + AB * AB - AO * AO) / (2 * BO * AB));
-        if (beta < M_PI / 2) 	// Acute triangle
-		{    
-            d_c = d_c_temp;
-            if (d_c_temp < radius)	// The collision occurs
-			    return {0, nullptr};    
-            
-            nearest_pts->col(0) = A + AO * cos(alpha) / AB * (B - A);
-            nearest_pts->col(1) = nearest_pts->col(0) + d_c / (obs.head(3) - nearest_pts->col(0)).norm() * (obs.head(3) - nearest_pts->col(0));
-        }
-        else
-		{
-            nearest_pts->col(1) = B + d_c / BO * (obs.head(3) - B);  
-            nearest_pts->col(0) = B;
-        }
-    }
-    else
-	{
-        nearest_pts->col(1) = A + d_c / AO * (obs.head(3) - A);  
-        nearest_pts->col(0) = A;
-    }
-    return {d_c, nearest_pts};
+	nearest_pts.col(0) = P;
+	nearest_pts.col(1) = O + obs(3) / PO * (P - O);
+	return d_c;
+}
+
+// Get distance between capsule (determined with line segment AB and 'radius') and oriented box, which is determined with 
+// its rotation 'R', its center 'center', and 'obs = (-h_x, -h_y, -h_z, h_x, h_y, h_z)' in its own frame ('h' are half-dimensions), 
+// while nearest points are stored into 'nearest_pts'. The capsule is transformed into the box frame, where the box is axis-aligned, 
+// and nearest points are transformed back.
+float base::CollisionAndDistance::distanceCapsuleToOrientedBox(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius, 
+	const Eigen::Matrix3f &R, const Eigen::Vector3f &center, const Eigen::VectorXf &obs, NearestPoints &nearest_pts)
+{
+	float d_c { distanceCapsuleToBox(R.transpose() * (A - center), R.transpose() * (B - center), radius, obs, nearest_pts) };
+	if (d_c > 0)
+		nearest_pts = (R * nearest_pts).colwise() + center;
+	
+	return d_c;
 }
 
 // ------------------------------------------------ Class CapsuleToBox -------------------------------------------------------//
-base::CollisionAndDistance::CapsuleToBox::CapsuleToBox(const Eigen::Vector3f &A_, const Eigen::Vector3f &B_, float radius_, Eigen::VectorXf &obs_)
+base::CollisionAndDistance::CapsuleToBox::CapsuleToBox(const Eigen::Vector3f &A_, const Eigen::Vector3f &B_, float radius_, 
+	const Eigen::VectorXf &obs_) : obs(obs_)
 {
 	A = A_;
 	B = B_;
-	AB = Eigen::MatrixXf(3, 2);
 	AB << A_, B_;
 	radius = radius_;
-	obs = obs_;
 	d_c = INFINITY;
-    nearest_pts = std::make_shared<Eigen::MatrixXf>(3, 2);
-	projections = Eigen::MatrixXi::Zero(6, 2);
+	projections = Eigen::Matrix<int, 6, 2>::Zero();
 	dist_AB_obs = Eigen::Vector2f(INFINITY, INFINITY);
 }
 
@@ -412,26 +541,23 @@ void base::CollisionAndDistance::CapsuleToBox::compute()
 	projectionLineSegOnSide(0, 2, 1, 3, 5, 4);   // Projection on y_min or y_max
 	projectionLineSegOnSide(0, 1, 2, 3, 4, 5);   // Projection on z_min or z_max     
 	if (d_c == 0)
-	{
-		nearest_pts = nullptr;
 		return;
-	}
 
 	size_t num_proj = (projections.col(0) + projections.col(1)).maxCoeff();
 	if (num_proj > 0) 					// Projection of one or two points exists
 	{
 		size_t idx_point = (dist_AB_obs(0) < dist_AB_obs(1)) ? 0 : 1;
 		d_c = dist_AB_obs.minCoeff();
-		nearest_pts->col(0) = AB.col(idx_point);
+		nearest_pts.col(0) = AB.col(idx_point);
 		Eigen::Index idx_coord {};
 		projections.col(idx_point).maxCoeff(&idx_coord);
 
 		if (idx_coord == 0 || idx_coord == 3)
-			nearest_pts->col(1) << obs(idx_coord), AB.col(idx_point).tail(2);
+			nearest_pts.col(1) << obs(idx_coord), AB.col(idx_point).tail(2);
 		else if (idx_coord == 1 || idx_coord == 4)
-			nearest_pts->col(1) << AB(0, idx_point), obs(idx_coord), AB(2, idx_point);
+			nearest_pts.col(1) << AB(0, idx_point), obs(idx_coord), AB(2, idx_point);
 		else if (idx_coord == 2 || idx_coord == 5)
-			nearest_pts->col(1) << AB.col(idx_point).head(2), obs(idx_coord);
+			nearest_pts.col(1) << AB.col(idx_point).head(2), obs(idx_coord);
 		
 		if (num_proj == 1)
 		{
@@ -475,11 +601,12 @@ void base::CollisionAndDistance::CapsuleToBox::projectionLineSegOnSide(size_t mi
 
 void base::CollisionAndDistance::CapsuleToBox::checkEdges(Eigen::Vector3f &point, size_t idx)
 {
-	std::shared_ptr<Eigen::MatrixXf> line_segments { nullptr };
+	Eigen::Matrix<float, 3, 4> line_segments {};
+	size_t num { 0 };
 	if (projections(0, idx))  		// Projection on x_min
 	{
 		if (!collisionCapsuleToRectangle(A, B, 0, obs, 0))
-			line_segments = getLineSegments(Eigen::Vector2f(point(1), point(2)), obs(1), obs(2), obs(4), obs(5), obs(0), 0);
+			num = getLineSegments(Eigen::Vector2f(point(1), point(2)), obs(1), obs(2), obs(4), obs(5), obs(0), 0, line_segments);
 		else
 		{
 			d_c = 0;
@@ -489,7 +616,7 @@ void base::CollisionAndDistance::CapsuleToBox::checkEdges(Eigen::Vector3f &point
 	else if (projections(3, idx))  	// Projection on x_max
 	{
 		if (!collisionCapsuleToRectangle(A, B, 0, obs, 3))           
-			line_segments = getLineSegments(Eigen::Vector2f(point(1), point(2)), obs(1), obs(2), obs(4), obs(5), obs(3), 0);
+			num = getLineSegments(Eigen::Vector2f(point(1), point(2)), obs(1), obs(2), obs(4), obs(5), obs(3), 0, line_segments);
 		else
 		{
 			d_c = 0;
@@ -499,7 +626,7 @@ void base::CollisionAndDistance::CapsuleToBox::checkEdges(Eigen::Vector3f &point
 	else if (projections(1, idx))  	// Projection on y_min
 	{
 		if (!collisionCapsuleToRectangle(A, B, 0, obs, 1))
-			line_segments = getLineSegments(Eigen::Vector2f(point(0), point(2)), obs(0), obs(2), obs(3), obs(5), obs(1), 1);
+			num = getLineSegments(Eigen::Vector2f(point(0), point(2)), obs(0), obs(2), obs(3), obs(5), obs(1), 1, line_segments);
 		else
 		{
 			d_c = 0;
@@ -509,7 +636,7 @@ void base::CollisionAndDistance::CapsuleToBox::checkEdges(Eigen::Vector3f &point
 	else if (projections(4, idx))  	// Projection on y_max
 	{
 		if (!collisionCapsuleToRectangle(A, B, 0, obs, 4))           
-			line_segments = getLineSegments(Eigen::Vector2f(point(0), point(2)), obs(0), obs(2), obs(3), obs(5), obs(4), 1);
+			num = getLineSegments(Eigen::Vector2f(point(0), point(2)), obs(0), obs(2), obs(3), obs(5), obs(4), 1, line_segments);
 		else
 		{
 			d_c = 0;
@@ -519,7 +646,7 @@ void base::CollisionAndDistance::CapsuleToBox::checkEdges(Eigen::Vector3f &point
 	else if (projections(2, idx))  	// Projection on z_min
 	{
 		if (!collisionCapsuleToRectangle(A, B, 0, obs, 2))
-			line_segments = getLineSegments(Eigen::Vector2f(point(0), point(1)), obs(0), obs(1), obs(3), obs(4), obs(2), 2);
+			num = getLineSegments(Eigen::Vector2f(point(0), point(1)), obs(0), obs(1), obs(3), obs(4), obs(2), 2, line_segments);
 		else
 		{
 			d_c = 0;
@@ -529,58 +656,57 @@ void base::CollisionAndDistance::CapsuleToBox::checkEdges(Eigen::Vector3f &point
 	else if (projections(5, idx))  	// Projection on z_max 
 	{
 		if (!collisionCapsuleToRectangle(A, B, 0, obs, 5))            
-			line_segments = getLineSegments(Eigen::Vector2f(point(0), point(1)), obs(0), obs(1), obs(3), obs(4), obs(5), 2);
+			num = getLineSegments(Eigen::Vector2f(point(0), point(1)), obs(0), obs(1), obs(3), obs(4), obs(5), 2, line_segments);
 		else
 		{
 			d_c = 0;
 			return;
 		}
 	}
-	distanceToMoreLineSegments(*line_segments);
+	distanceToMoreLineSegments(line_segments.leftCols(num));
 }
 
-std::shared_ptr<Eigen::MatrixXf> base::CollisionAndDistance::CapsuleToBox::getLineSegments
-	(const Eigen::Vector2f &point, float min1, float min2, float max1, float max2, float coord_value, size_t coord)
+size_t base::CollisionAndDistance::CapsuleToBox::getLineSegments(const Eigen::Vector2f &point, float min1, float min2, float max1, float max2, 
+	float coord_value, size_t coord, Eigen::Matrix<float, 3, 4> &line_segments)
 {
-	std::shared_ptr<Eigen::MatrixXf> line_segments { std::make_shared<Eigen::MatrixXf>(3, 2) };
 	size_t num { 0 };
 
 	if (point(0) < min1)
 	{
-		line_segments->col(0) = get3DPoint(Eigen::Vector2f(min1, min2), coord_value, coord);
-		line_segments->col(1) = get3DPoint(Eigen::Vector2f(min1, max2), coord_value, coord);
+		line_segments.col(0) = get3DPoint(Eigen::Vector2f(min1, min2), coord_value, coord);
+		line_segments.col(1) = get3DPoint(Eigen::Vector2f(min1, max2), coord_value, coord);
 		num += 2;
 	}
 	else if (point(0) > max1)
 	{
-		line_segments->col(0) = get3DPoint(Eigen::Vector2f(max1, min2), coord_value, coord);
-		line_segments->col(1) = get3DPoint(Eigen::Vector2f(max1, max2), coord_value, coord);
+		line_segments.col(0) = get3DPoint(Eigen::Vector2f(max1, min2), coord_value, coord);
+		line_segments.col(1) = get3DPoint(Eigen::Vector2f(max1, max2), coord_value, coord);
 		num += 2;
 	}
 				
 	if (point(1) < min2)
 	{
-		line_segments->conservativeResize(3, 2 + num);
-		line_segments->col(num) 	= get3DPoint(Eigen::Vector2f(min1, min2), coord_value, coord);
-		line_segments->col(num + 1) = get3DPoint(Eigen::Vector2f(max1, min2), coord_value, coord);
+		line_segments.col(num) 	   = get3DPoint(Eigen::Vector2f(min1, min2), coord_value, coord);
+		line_segments.col(num + 1) = get3DPoint(Eigen::Vector2f(max1, min2), coord_value, coord);
+		num += 2;
 	}
 	else if (point(1) > max2)
 	{
-		line_segments->conservativeResize(3, 2 + num);
-		line_segments->col(num) 	= get3DPoint(Eigen::Vector2f(min1, max2), coord_value, coord);
-		line_segments->col(num + 1) = get3DPoint(Eigen::Vector2f(max1, max2), coord_value, coord);
+		line_segments.col(num) 	   = get3DPoint(Eigen::Vector2f(min1, max2), coord_value, coord);
+		line_segments.col(num + 1) = get3DPoint(Eigen::Vector2f(max1, max2), coord_value, coord);
+		num += 2;
 	}
-	return line_segments;	
+	return num;	
 }
 	
-void base::CollisionAndDistance::CapsuleToBox::distanceToMoreLineSegments(const Eigen::MatrixXf &line_segments)
+void base::CollisionAndDistance::CapsuleToBox::distanceToMoreLineSegments(const Eigen::Ref<const Eigen::Matrix3Xf> &line_segments)
 {
 	float d_c_temp { 0 };
-	std::shared_ptr<Eigen::MatrixXf> nearest_pts_temp { nullptr };
+	NearestPoints nearest_pts_temp {};
 	
 	for (int k = 0; k < line_segments.cols(); k += 2)
 	{
-		tie(d_c_temp, nearest_pts_temp) = distanceLineSegToLineSeg(A, B, line_segments.col(k), line_segments.col(k+1));
+		d_c_temp = distanceLineSegToLineSeg(A, B, line_segments.col(k), line_segments.col(k+1), nearest_pts_temp);
 		if (d_c_temp <= 0)
 		{
 			d_c = 0;
@@ -589,7 +715,7 @@ void base::CollisionAndDistance::CapsuleToBox::distanceToMoreLineSegments(const
 		else if (d_c_temp < d_c)
 		{
 			d_c = d_c_temp;
-			*nearest_pts = *nearest_pts_temp;
+			nearest_pts = nearest_pts_temp;
 		}
 	}
 }
@@ -601,34 +727,34 @@ void base::CollisionAndDistance::CapsuleToBox::checkOtherCases()
 		if (A(1) < obs(1) && B(1) < obs(1))
 		{
 			if (A(2) < obs(2) && B(2) < obs(2)) 		// < x_min, < y_min, < z_min
-				tie(d_c, nearest_pts) = distanceLineSegToPoint(A, B, Eigen::Vector3f(obs(0), obs(1), obs(2)));
+				d_c = distanceLineSegToPoint(A, B, Eigen::Vector3f(obs(0), obs(1), obs(2)), nearest_pts);
 			else if (A(2) > obs(5) && B(2) > obs(5)) 	// < x_min, < y_min, > z_max
-				tie(d_c, nearest_pts) = distanceLineSegToPoint(A, B, Eigen::Vector3f(obs(0), obs(1), obs(5)));
+				d_c = distanceLineSegToPoint(A, B, Eigen::Vector3f(obs(0), obs(1), obs(5)), nearest_pts);
 			else    									// < x_min, < y_min
-				tie(d_c, nearest_pts) = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(0), obs(1), obs(2)), 
-																 	   Eigen::Vector3f(obs(0), obs(1), obs(5)));
+				d_c = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(0), obs(1), obs(2)),
+													 Eigen::Vector3f(obs(0), obs(1), obs(5)), nearest_pts);
 		}
 		else if (A(1) > obs(4) && B(1) > obs(4))
 		{
 			if (A(2) < obs(2) && B(2) < obs(2)) 		// < x_min, > y_max, < z_min
-				tie(d_c, nearest_pts) = distanceLineSegToPoint(A, B, Eigen::Vector3f(obs(0), obs(4), obs(2)));                        
+				d_c = distanceLineSegToPoint(A, B, Eigen::Vector3f(obs(0), obs(4), obs(2)), nearest_pts);                        
 			else if (A(2) > obs(5) && B(2) > obs(5)) 	// < x_min, > y_max, > z_max
-				tie(d_c, nearest_pts) = distanceLineSegToPoint(A, B, Eigen::Vector3f(obs(0), obs(4), obs(5)));
+				d_c = distanceLineSegToPoint(A, B, Eigen::Vector3f(obs(0), obs(4), obs(5)), nearest_pts);
 			else    									// < x_min, > y_max
-				tie(d_c, nearest_pts) = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(0), obs(4), obs(2)), 
-																 	   Eigen::Vector3f(obs(0), obs(4), obs(5)));
+				d_c = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(0), obs(4), obs(2)),
+													 Eigen::Vector3f(obs(0), obs(4), obs(5)), nearest_pts);
 		}
 		else
 		{
 			if (A(2) < obs(2) && B(2) < obs(2)) 		// < x_min, < z_min
-				tie(d_c, nearest_pts) = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(0), obs(1), obs(2)), 
-																 	   Eigen::Vector3f(obs(0), obs(4), obs(2)));
+				d_c = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(0), obs(1), obs(2)),
+													 Eigen::Vector3f(obs(0), obs(4), obs(2)), nearest_pts);
 			else if (A(2) > obs(5) && B(2) > obs(5)) 	// < x_min, > z_max
-				tie(d_c, nearest_pts) = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(0), obs(1), obs(5)), 
-																 	   Eigen::Vector3f(obs(0), obs(4), obs(5)));
+				d_c = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(0), obs(1), obs(5)),
+													 Eigen::Vector3f(obs(0), obs(4), obs(5)), nearest_pts);
 			else    									// < x_min
 			{
-				Eigen::MatrixXf line_segments(3, 8);
+				Eigen::Matrix<float, 3, 8> line_segments {};
 				line_segments << obs(0), obs(0), obs(0), obs(0), obs(0), obs(0), obs(0), obs(0), 
 								 obs(1), obs(4), obs(4), obs(4), obs(4), obs(1), obs(1), obs(1), 
 								 obs(2), obs(2), obs(2), obs(5), obs(5), obs(5), obs(5), obs(2);
@@ -642,34 +768,34 @@ void base::CollisionAndDistance::CapsuleToBox::checkOtherCases()
 		if (A(1) < obs(1) && B(1) < obs(1))
 		{
 			if (A(2) < obs(2) && B(2) < obs(2)) 		// > x_max, < y_min, < z_min
-				tie(d_c, nearest_pts) = distanceLineSegToPoint(A, B, Eigen::Vector3f(obs(3), obs(1), obs(2)));
+				d_c = distanceLineSegToPoint(A, B, Eigen::Vector3f(obs(3), obs(1), obs(2)), nearest_pts);
 			else if (A(2) > obs(5) && B(2) > obs(5)) 	// > x_max, < y_min, > z_max
-				tie(d_c, nearest_pts) = distanceLineSegToPoint(A, B, Eigen::Vector3f(obs(3), obs(1), obs(5)));
+				d_c = distanceLineSegToPoint(A, B, Eigen::Vector3f(obs(3), obs(1), obs(5)), nearest_pts);
 			else    									// > x_max, < y_min
-				tie(d_c, nearest_pts) = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(3), obs(1), obs(2)),
-																 	   Eigen::Vector3f(obs(3), obs(1), obs(5)));                    
+				d_c = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(3), obs(1), obs(2)),
+													 Eigen::Vector3f(obs(3), obs(1), obs(5)), nearest_pts);                    
 		}
 		else if (A(1) > obs(4) && B(1) > obs(4))
 		{
 			if (A(2) < obs(2) && B(2) < obs(2)) 		// > x_max, > y_max, < z_min
-				tie(d_c, nearest_pts) = distanceLineSegToPoint(A, B, Eigen::Vector3f(obs(3), obs(4), obs(2)));
+				d_c = distanceLineSegToPoint(A, B, Eigen::Vector3f(obs(3), obs(4), obs(2)), nearest_pts);
 			else if (A(2) > obs(5) && B(2) > obs(5)) 	// > x_max, > y_max, > z_max
-				tie(d_c, nearest_pts) = distanceLineSegToPoint(A, B, Eigen::Vector3f(obs(3), obs(4), obs(5)));
+				d_c = distanceLineSegToPoint(A, B, Eigen::Vector3f(obs(3), obs(4), obs(5)), nearest_pts);
 			else    									// > x_max, > y_max
-				tie(d_c, nearest_pts) = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(3), obs(4), obs(2)), 
-																 	   Eigen::Vector3f(obs(3), obs(4), obs(5)));                     
+				d_c = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(3), obs(4), obs(2)),
+													 Eigen::Vector3f(obs(3), obs(4), obs(5)), nearest_pts);                     
 		}
 		else
 		{
 			if (A(2) < obs(2) && B(2) < obs(2)) 		// > x_max, < z_min
-				tie(d_c, nearest_pts) = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(3), obs(1), obs(2)),
-																 	   Eigen::Vector3f(obs(3), obs(4), obs(2)));
+				d_c = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(3), obs(1), obs(2)),
+													 Eigen::Vector3f(obs(3), obs(4), obs(2)), nearest_pts);
 			else if (A(2) > obs(5) && B(2) > obs(5)) 	// > x_max, > z_max
-				tie(d_c, nearest_pts) = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(3), obs(1), obs(5)), 
-																 	   Eigen::Vector3f(obs(3), obs(4), obs(5)));
+				d_c = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(3), obs(1), obs(5)),
+													 Eigen::Vector3f(obs(3), obs(4), obs(5)), nearest_pts);
 			else    									// > x_max
 			{
-				Eigen::MatrixXf line_segments(3, 8);
+				Eigen::Matrix<float, 3, 8> line_segments {};
 				line_segments << obs(3), obs(3), obs(3), obs(3), obs(3), obs(3), obs(3), obs(3), 
 								 obs(1), obs(4), obs(4), obs(4), obs(4), obs(1), obs(1), obs(1), 
 								 obs(2), obs(2), obs(2), obs(5), obs(5), obs(5), obs(5), obs(2);
@@ -683,14 +809,14 @@ void base::CollisionAndDistance::CapsuleToBox::checkOtherCases()
 		if (A(1) < obs(1) && B(1) < obs(1))
 		{
 			if (A(2) < obs(2) && B(2) < obs(2)) 		// < y_min, < z_min
-				tie(d_c, nearest_pts) = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(0), obs(1), obs(2)), 
-																 	   Eigen::Vector3f(obs(3), obs(1), obs(2))); 
+				d_c = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(0), obs(1), obs(2)),
+													 Eigen::Vector3f(obs(3), obs(1), obs(2)), nearest_pts); 
 			else if (A(2) > obs(5) && B(2) > obs(5)) 	// < y_min, > z_max
-				tie(d_c, nearest_pts) = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(0), obs(1), obs(5)), 
-																 	   Eigen::Vector3f(obs(3), obs(1), obs(5))); 
+				d_c = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(0), obs(1), obs(5)),
+													 Eigen::Vector3f(obs(3), obs(1), obs(5)), nearest_pts); 
 			else    									// < y_min
 			{
-				Eigen::MatrixXf line_segments(3, 8);
+				Eigen::Matrix<float, 3, 8> line_segments {};
 				line_segments << obs(0), obs(3), obs(3), obs(3), obs(3), obs(0), obs(0), obs(0),
 								 obs(1), obs(1), obs(1), obs(1), obs(1), obs(1), obs(1), obs(1),
 								 obs(2), obs(2), obs(2), obs(5), obs(5), obs(5), obs(5), obs(2);
@@ -700,14 +826,14 @@ void base::CollisionAndDistance::CapsuleToBox::checkOtherCases()
 		else if (A(1) > obs(4) && B(1) > obs(4))
 		{
 			if (A(2) < obs(2) && B(2) < obs(2)) 		// > y_max, < z_min
-				tie(d_c, nearest_pts) = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(0), obs(4), obs(2)), 
-																 	   Eigen::Vector3f(obs(3), obs(4), obs(2)));                        
+				d_c = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(0), obs(4), obs(2)),
+													 Eigen::Vector3f(obs(3), obs(4), obs(2)), nearest_pts);                        
 			else if (A(2) > obs(5) && B(2) > obs(5)) 	// > y_max, > z_max
-				tie(d_c, nearest_pts) = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(0), obs(4), obs(5)),
-																 	   Eigen::Vector3f(obs(3), obs(4), obs(5)));                             
+				d_c = distanceLineSegToLineSeg(A, B, Eigen::Vector3f(obs(0), obs(4), obs(5)),
+													 Eigen::Vector3f(obs(3), obs(4), obs(5)), nearest_pts);                             
 			else    									// > y_max
 			{
-				Eigen::MatrixXf line_segments(3, 8);
+				Eigen::Matrix<float, 3, 8> line_segments {};
 				line_segments << obs(0), obs(3), obs(3), obs(3), obs(3), obs(0), obs(0), obs(0),
 								 obs(4), obs(4), obs(4), obs(4), obs(4), obs(4), obs(4), obs(4),
 								 obs(2), obs(2), obs(2), obs(5), obs(5), obs(5), obs(5), obs(2);
@@ -718,7 +844,7 @@ void base::CollisionAndDistance::CapsuleToBox::checkOtherCases()
 		{
 			if (A(2) < obs(2) && B(2) < obs(2)) 		// < z_min
 			{
-				Eigen::MatrixXf line_segments(3, 8);
+				Eigen::Matrix<float, 3, 8> line_segments {};
 				line_segments << obs(0), obs(3), obs(3), obs(3), obs(3), obs(0), obs(0), obs(0), 
 								 obs(1), obs(1), obs(1), obs(4), obs(4), obs(4), obs(4), obs(1), 
 								 obs(2), obs(2), obs(2), obs(2), obs(2), obs(2), obs(2), obs(2);
@@ -727,7 +853,7 @@ void base::CollisionAndDistance::CapsuleToBox::checkOtherCases()
 											
 			else if (A(2) > obs(5) && B(2) > obs(5)) 	// > z_max
 			{
-				Eigen::MatrixXf line_segments(3, 8);
+				Eigen::Matrix<float, 3, 8> line_segments {};
 				line_segments << obs(0), obs(3), obs(3), obs(3), obs(3), obs(0), obs(0), obs(0), 
 								 obs(1), obs(1), obs(1), obs(4), obs(4), obs(4), obs(4), obs(1), 
 								 obs(5), obs(5), obs(5), obs(5), obs(5), obs(5), obs(5), obs(5);
@@ -744,7 +870,7 @@ void base::CollisionAndDistance::CapsuleToBox::checkOtherCases()
 						return;
 					}
 				}
-				Eigen::MatrixXf line_segments(3, 24);
+				Eigen::Matrix<float, 3, 24> line_segments {};
 				line_segments << obs(0), obs(3), obs(3), obs(3), obs(3), obs(0), obs(0), obs(0), obs(0), obs(3), obs(3), obs(3), obs(3), obs(0), obs(0), obs(0), obs(0), obs(0), obs(3), obs(3), obs(3), obs(3), obs(0), obs(0),
 								 obs(1), obs(1), obs(1), obs(4), obs(4), obs(4), obs(4), obs(1), obs(1), obs(1), obs(1), obs(4), obs(4), obs(4), obs(4), obs(1), obs(1), obs(1), obs(1), obs(1), obs(4), obs(4), obs(4), obs(4),
 								 obs(2), obs(2), obs(2), obs(2), obs(2), obs(2), obs(2), obs(2), obs(5), obs(5), obs(5), obs(5), obs(5), obs(5), obs(5), obs(5), obs(2), obs(5), obs(2), obs(5), obs(2), obs(5), obs(2), obs(5);
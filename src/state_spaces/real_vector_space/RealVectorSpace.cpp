@@ -3,12 +3,35 @@
 base::RealVectorSpace::RealVectorSpace(size_t num_dimensions_) : StateSpace(num_dimensions_)
 {
 	setStateSpaceType(base::StateSpaceType::RealVectorSpace);
+	q_coord_scratch = Eigen::VectorXf(num_dimensions);
+	num_ground_boxes = 0;
+	obstacles_env = nullptr;
+	obstacles_version = std::numeric_limits<size_t>::max();
+	broad_phase_threshold = 0;
+	use_grid = false;
+	grid_query = 0;
+	obs_scratch = Eigen::VectorXf(6);
+	sphere_scratch = Eigen::VectorXf(4);
+	edge_check_order_type = RealVectorSpaceConfig::EDGE_CHECK_ORDER;
 }
 
 base::RealVectorSpace::RealVectorSpace(size_t num_dimensions_, const std::shared_ptr<robots::AbstractRobot> robot_, 
 	const std::shared_ptr<env::Environment> env_) : StateSpace(num_dimensions_, robot_, env_)	
 {
 	setStateSpaceType(base::StateSpaceType::RealVectorSpace);
+	q_coord_scratch = Eigen::VectorXf(num_dimensions);
+	skeleton_scratch = Eigen::MatrixXf(3, num_dimensions + 1);	// Resized by 'robot->computeSkeleton' if the robot has more links
+	num_ground_boxes = 0;
+	obstacles_env = nullptr;
+	obstacles_version = std::numeric_limits<size_t>::max();
+	broad_phase_threshold = 0;
+	use_grid = false;
+	grid_query = 0;
+	obs_scratch = Eigen::VectorXf(6);
+	sphere_scratch = Eigen::VectorXf(4);
+	edge_check_order_type = RealVectorSpaceConfig::EDGE_CHECK_ORDER;
+	if (RealVectorSpaceConfig::WEIGHTED_METRIC && robot != nullptr)
+		setMetricWeights(computeMetricWeights());
 }
 
 base::RealVectorSpace::~RealVectorSpace() {}
@@ -40,15 +63,39 @@ std::shared_ptr<base::State> base::RealVectorSpace::getRandomState(const std::sh
 }
 
 // Get completely a new state with the same coordinates as 'state'
+// The state is allocated from 'state_pool' if it is set.
 std::shared_ptr<base::State> base::RealVectorSpace::getNewState(const Eigen::VectorXf &coord)
 {
-	return std::make_shared<base::RealVectorSpaceState>(coord);
+	if (state_pool == nullptr)
+		return std::make_shared<base::RealVectorSpaceState>(coord);
+	
+	return std::allocate_shared<base::RealVectorSpaceState>
+		(base::StatePoolAllocator<base::RealVectorSpaceState>(state_pool), coord);
 }
 
 // Get Euclidean distance between two states (get norm of the vector 'q2 - q1')
+// If 'metric_weights' are set, each coordinate of 'q2 - q1' is multiplied by its weight. 
+// Since 'interpolateEdge' measures 'step' using this norm, edges are interpolated consistently with the weighted metric.
 inline float base::RealVectorSpace::getNorm(const std::shared_ptr<base::State> q1, const std::shared_ptr<base::State> q2)
 {
-	return (q1->getCoord() - q2->getCoord()).norm();
+	if (metric_weights.size() == 0)
+		return (q1->getCoord() - q2->getCoord()).norm();
+
+	return (q1->getCoord() - q2->getCoord()).cwiseProduct(metric_weights).norm();
+}
+
+// Compute the weight of each joint as the radius of the sphere (centred at the joint) enclosing all subsequent links 
+// in the zero configuration, i.e., the largest workspace displacement per unit motion of the joint.
+// A joint whose subsequent links lie on its axis (e.g., the last joint of 'xArm6') gets a zero radius, so each weight 
+// is clamped to at least the mean weight. Otherwise, such joint would be free in the metric, and 'interpolateEdge' 
+// could take arbitrarily large steps in it.
+// Weights are normalized such that their root mean square is one, so the metric keeps the scale of the Euclidean one.
+Eigen::VectorXf base::RealVectorSpace::computeMetricWeights()
+{
+	std::shared_ptr<Eigen::MatrixXf> R { robot->computeEnclosingRadii(getNewState(Eigen::VectorXf::Zero(num_dimensions))) };
+	Eigen::VectorXf weights { R->col(num_dimensions).cwiseMax(R->col(num_dimensions).mean()) };
+	
+	return weights / std::sqrt(weights.squaredNorm() / num_dimensions);
 }
 
 // Check if two states are equal
@@ -60,10 +107,12 @@ bool base::RealVectorSpace::isEqual(const std::shared_ptr<base::State> q1, const
 	return false;
 }
 
-// Check if two vectors are equal
+// Check if two vectors are equal (using the same metric as 'getNorm')
 bool base::RealVectorSpace::isEqual(const Eigen::VectorXf &q1_coord, const Eigen::VectorXf &q2_coord)
 {
-	if ((q1_coord - q2_coord).norm() < RealVectorSpaceConfig::EQUALITY_THRESHOLD)
+	const float d { metric_weights.size() == 0 ? (q1_coord - q2_coord).norm() : 
+												 (q1_coord - q2_coord).cwiseProduct(metric_weights).norm() };
+	if (d < RealVectorSpaceConfig::EQUALITY_THRESHOLD)
 		return true;
 	
 	return false;
@@ -259,54 +308,378 @@ void base::RealVectorSpace::preprocessPath(const std::vector<std::shared_ptr<bas
     // std::cout << std::endl;
 }
 
+// Check whether the edge [q1, q2] is collision-free by checking 'NUM_INTERPOLATION_VALIDITY_CHECKS' equidistant configurations.
+// Configurations are checked in the order given by 'RealVectorSpaceConfig::EDGE_CHECK_ORDER'.
+// If 'RealVectorSpaceConfig::CERTIFIED_EDGE_VALIDATION' is true, parts of the edge near 'q1' and 'q2' that are proved 
+// collision-free (see 'computeCertifiedFraction') are not checked. A distance is computed only for 'q1' (if not already), 
+// while the available distance of 'q2' is used if it exists.
+// Interpolated configurations are only checked and never stored, so they are computed in scratch buffers without creating states.
+// They are checked in chunks by 'isValidBatch', so the forward kinematics of each chunk is computed at once.
 bool base::RealVectorSpace::isValid(const std::shared_ptr<base::State> q1, const std::shared_ptr<base::State> q2)
 {
 	size_t num_checks { RealVectorSpaceConfig::NUM_INTERPOLATION_VALIDITY_CHECKS };
-	float dist { getNorm(q1, q2) };
-	std::shared_ptr<base::State> q_new { nullptr };
+	if (edge_check_order.size() != num_checks || edge_check_order_type != RealVectorSpaceConfig::EDGE_CHECK_ORDER)
+	{
+		edge_check_order = computeEdgeCheckOrder(num_checks, RealVectorSpaceConfig::EDGE_CHECK_ORDER);
+		edge_check_order_type = RealVectorSpaceConfig::EDGE_CHECK_ORDER;
+	}
+
+	float t1 { 0 };		// Fraction of the edge from 'q1' that is collision-free
+	float t2 { 0 };		// Fraction of the edge from 'q2' that is collision-free
+	if (RealVectorSpaceConfig::CERTIFIED_EDGE_VALIDATION)
+	{
+		// Only real distances are used, since an underestimation may ignore obstacles without nearest points
+		t1 = computeCertifiedFraction(q1, q2, q1->getDistance() != -1 && q1->getIsRealDistance() ? 
+			q1->getDistance() : computeDistance(q1, false));
+		if (q2->getDistance() != -1 && q2->getIsRealDistance())	// -1 means that the distance is not computed
+			t2 = computeCertifiedFraction(q2, q1, q2->getDistance());
+		
+		if (t1 + t2 >= 1)
+			return true;
+	}
+
+	// The last chunk is padded with its last configuration, so the size of 'q_coords_batch' is never changed
+	const size_t chunk_size { robots::ForwardKinematics::Chunk::SizeAtCompileTime };
+	q_coords_batch.resize(num_dimensions, chunk_size);
+	size_t num_configs { 0 };
+	float t { 0 };
+	for (size_t idx = 0; idx < edge_check_order.size(); idx++)
+	{
+		t = float(edge_check_order[idx]) / num_checks;
+		if (t >= t1 && 1 - t >= t2)
+			q_coords_batch.col(num_configs++) = (q1->getCoord() + (q2->getCoord() - q1->getCoord()) * t).array();
+
+		if (num_configs == chunk_size || (idx == edge_check_order.size() - 1 && num_configs > 0))
+		{
+			for (size_t n = num_configs; n < chunk_size; n++)
+				q_coords_batch.col(n) = q_coords_batch.col(num_configs - 1);
 
-	for (float k = num_checks; k >= 1; k--)
+			if (!isValidBatch(q_coords_batch, num_configs))
+				return false;
+			
+			num_configs = 0;
+		}
+	}
+
+	return true;
+}
+
+// Check the validity of the first 'num_configs' configurations (in order) from the batch 'q_coords', where each column is one configuration.
+// Skeletons of all configurations from the batch are computed at once by 'robot->computeSkeletons'.
+bool base::RealVectorSpace::isValidBatch(const robots::BatchSoA &q_coords, size_t num_configs)
+{
+	robot->computeSkeletons(q_coords, skeletons_batch);
+	for (size_t n = 0; n < num_configs; n++)
 	{
-		q_new = interpolateEdge(q1, q2, k / num_checks * dist, dist);
-		if (!isValid(q_new))
+		skeleton_scratch = Eigen::Map<const Eigen::MatrixXf, 0, Eigen::InnerStride<>>
+			(skeletons_batch.data() + n, 3, skeletons_batch.rows() / 3, Eigen::InnerStride<>(skeletons_batch.cols()));
+		if (!isValidSkeleton(skeleton_scratch))
 			return false;
 	}
 
 	return true;
 }
 
+// Compute the fraction of the edge from 'q' to 'q_e' that is proved collision-free, when 'd_c' is the distance-to-obstacles in 'q'.
+// Along the edge, each robot's point moves in W-space at most 'rho = R->col(num_dimensions).dot(|q_e - q|)', where 'R' are 
+// the enclosing radii in 'q' (as in RBT-based algorithms). Thus, the robot cannot reach obstacles before the fraction 'd_c / rho'.
+// Since 'd_c' ignores obstacles farther than their 'min_dist_tol', it is a lower bound on the real distance only up to 
+// the smallest tolerance, so 'd_c' is clipped to it.
+float base::RealVectorSpace::computeCertifiedFraction(const std::shared_ptr<base::State> q, const std::shared_ptr<base::State> q_e, float d_c)
+{
+	updateObstacles();
+	if (obstacle_min_dist_tols.size() > 0)
+		d_c = std::min(d_c, obstacle_min_dist_tols.minCoeff());
+
+	float rho { robot->computeEnclosingRadii(q)->col(num_dimensions).dot((q_e->getCoord() - q->getCoord()).cwiseAbs()) };
+	return rho > 0 ? d_c / rho : INFINITY;
+}
+
+// Compute the order in which 'num_checks' equidistant configurations of the edge [q1, q2] are checked.
+// Index k (from 1 to 'num_checks') denotes the configuration at k / num_checks of the edge, i.e., 'q2' has index 'num_checks'.
+// In the bisection order, 'q2' is checked first, and then midpoints of the remaining intervals level by level, 
+// so the checked configurations cover the whole edge as soon as possible, and a collision is usually found earlier.
+std::vector<size_t> base::RealVectorSpace::computeEdgeCheckOrder(size_t num_checks, base::EdgeCheckOrder order)
+{
+	std::vector<size_t> indices {};
+	indices.reserve(num_checks);
+
+	switch (order)
+	{
+	case base::EdgeCheckOrder::Backward:
+		for (size_t k = num_checks; k >= 1; k--)
+			indices.emplace_back(k);
+		break;
+
+	case base::EdgeCheckOrder::Forward:
+		for (size_t k = 1; k <= num_checks; k++)
+			indices.emplace_back(k);
+		break;
+
+	case base::EdgeCheckOrder::Bisection:
+		if (num_checks == 0)
+			break;
+		
+		indices.emplace_back(num_checks);
+		std::queue<std::pair<size_t, size_t>> intervals {};		// Open intervals of indices that are not checked yet
+		intervals.emplace(0, num_checks);
+		while (!intervals.empty())
+		{
+			auto [lower, upper] = intervals.front();
+			intervals.pop();
+			if (upper - lower < 2)
+				continue;
+
+			size_t mid { (lower + upper) / 2 };
+			indices.emplace_back(mid);
+			intervals.emplace(lower, mid);
+			intervals.emplace(mid, upper);
+		}
+		break;
+	}
+
+	return indices;
+}
+
 bool base::RealVectorSpace::isValid(const std::shared_ptr<base::State> q)
 {
-	std::shared_ptr<Eigen::MatrixXf> skeleton { robot->computeSkeleton(q) };
-	
+	return isValidSkeleton(*robot->computeSkeleton(q));
+}
+
+// Check the validity of the configuration 'q_coord', which is not stored as a state.
+bool base::RealVectorSpace::isValid(const Eigen::VectorXf &q_coord)
+{
+	robot->computeSkeleton(q_coord, skeleton_scratch);
+	return isValidSkeleton(skeleton_scratch);
+}
+
+// Check whether the robot, whose links are capsules determined by 'skeleton', collides with obstacles.
+// All box obstacles are checked against each link at once using 'collisionCapsuleToBoxes'.
+bool base::RealVectorSpace::isValidSkeleton(const Eigen::MatrixXf &skeleton)
+{
+	updateObstacles();
+
 	for (size_t i = 0; i < robot->getNumLinks(); i++)
 	{
-    	for (size_t j = 0; j < env->getNumObjects(); j++)
+		if (use_grid)
 		{
-			if (env->getObject(j)->getLabel() == "ground" && i < robot->getGroundIncluded())
-				continue;
-            else if (env->getCollObject(j)->getNodeType() == fcl::NODE_TYPE::GEOM_BOX)
+			if (collisionCapsuleToGridBoxes(skeleton.col(i), skeleton.col(i+1), robot->getCapsuleRadius(i)))
+				return false;
+			
+			for (size_t j = 0; j < num_ground_boxes && i >= robot->getGroundIncluded(); j++)
 			{
-				// std::cout << "(i,j) = (" <<i<<","<<j<<")" << std::endl;
-				// std::cout << "r(i): " << robot->getCapsuleRadius(i) << std::endl;
-				// std::cout << "skeleton(i):   " << skeleton->col(i).transpose() << std::endl;
-				// std::cout << "skeleton(i+1): " << skeleton->col(i+1).transpose() << std::endl;
-				fcl::AABB AABB { env->getCollObject(j)->getAABB() };
-				Eigen::VectorXf obs(6);
-				obs << AABB.min_[0], AABB.min_[1], AABB.min_[2], AABB.max_[0], AABB.max_[1], AABB.max_[2];
-				if (collisionCapsuleToBox(skeleton->col(i), skeleton->col(i+1), robot->getCapsuleRadius(i), obs))
+				obs_scratch = boxes.col(j);
+				if (collisionCapsuleToBox(skeleton.col(i), skeleton.col(i+1), robot->getCapsuleRadius(i), obs_scratch))
 					return false;
-            }
-			else if (env->getCollObject(j)->getNodeType() == fcl::NODE_TYPE::GEOM_SPHERE)
+			}
+		}
+		// Ground boxes are skipped for the first 'robot->getGroundIncluded()' links
+		else if (collisionCapsuleToBoxes(skeleton.col(i), skeleton.col(i+1), robot->getCapsuleRadius(i), boxes, 
+										 i < robot->getGroundIncluded() ? num_ground_boxes : 0))
+			return false;
+
+		for (size_t k = 0; k < sphere_indices.size(); k++)
+		{
+			if (obstacle_is_ground[sphere_indices[k]] && i < robot->getGroundIncluded())
+				continue;
+			
+			sphere_scratch = spheres.col(k);
+			if (collisionCapsuleToSphere(skeleton.col(i), skeleton.col(i+1), robot->getCapsuleRadius(i), sphere_scratch))
+				return false;
+		}
+
+		for (size_t k = 0; k < oriented_box_indices.size(); k++)
+		{
+			if (obstacle_is_ground[oriented_box_indices[k]] && i < robot->getGroundIncluded())
+				continue;
+			
+			obs_scratch = oriented_boxes.col(k);
+			if (collisionCapsuleToOrientedBox(skeleton.col(i), skeleton.col(i+1), robot->getCapsuleRadius(i), 
+											  oriented_box_rotations[k], oriented_box_centers.col(k), obs_scratch))
+				return false;
+		}
+	}
+
+	return true;
+}
+
+// Update the snapshot of obstacles (their types, AABBs, minimal distance tolerances and ground flags) if the environment is changed.
+// Moreover, AABBs of all axis-aligned box obstacles are packed into 'boxes', such that ground boxes come first, 
+// and indices of sphere obstacles are collected together with their centers and radii packed into 'spheres'.
+// Box obstacles whose rotation is not a signed permutation (i.e., their AABB is larger than the box itself) are treated as oriented, 
+// and their dimensions, rotations and centers are packed into 'oriented_boxes', 'oriented_box_rotations' and 'oriented_box_centers'.
+void base::RealVectorSpace::updateObstacles()
+{
+	if (obstacles_env == env && obstacles_version == env->getVersion() && 
+		broad_phase_threshold == RealVectorSpaceConfig::BROAD_PHASE_THRESHOLD)
+		return;
+	
+	const size_t num_obstacles { env->getNumObjects() };
+	obstacle_types.resize(num_obstacles);
+	obstacle_is_ground.resize(num_obstacles);
+	obstacle_bounds.resize(6, num_obstacles);
+	obstacle_min_dist_tols.resize(num_obstacles);
+	obstacle_is_oriented.assign(num_obstacles, false);
+	obstacle_packed_idx.assign(num_obstacles, 0);
+	sphere_indices.clear();
+	oriented_box_indices.clear();
+	size_t num_boxes { 0 };
+	num_ground_boxes = 0;
+
+	for (size_t j = 0; j < num_obstacles; j++)
+	{
+		const fcl::AABB<float> &AABB { env->getCollObject(j)->getAABB() };
+		obstacle_types[j] = env->getCollObject(j)->getNodeType();
+		obstacle_is_ground[j] = (env->getObject(j)->getLabel() == "ground");
+		obstacle_bounds.col(j) << AABB.min_[0], AABB.min_[1], AABB.min_[2], AABB.max_[0], AABB.max_[1], AABB.max_[2];
+		obstacle_min_dist_tols(j) = env->getObject(j)->getMinDistTol();
+
+		if (obstacle_types[j] == fcl::NODE_TYPE::GEOM_BOX)
+		{
+			const Eigen::Matrix3f R { env->getCollObject(j)->getRotation() };
+			obstacle_is_oriented[j] = !R.cwiseAbs().rowwise().maxCoeff().isOnes(RealVectorSpaceConfig::EQUALITY_THRESHOLD);
+			if (obstacle_is_oriented[j])
 			{
-				Eigen::VectorXf obs(4); 	// TODO
-                if (collisionCapsuleToSphere(skeleton->col(i), skeleton->col(i+1), robot->getCapsuleRadius(i), obs))
-					return false;
-            }
-        }
-    }
+				obstacle_packed_idx[j] = oriented_box_indices.size();
+				oriented_box_indices.emplace_back(j);
+			}
+			else
+			{
+				num_boxes++;
+				num_ground_boxes += obstacle_is_ground[j];
+			}
+		}
+		else if (obstacle_types[j] == fcl::NODE_TYPE::GEOM_SPHERE)
+		{
+			obstacle_packed_idx[j] = sphere_indices.size();
+			sphere_indices.emplace_back(j);
+		}
+	}
+
+	spheres.resize(4, sphere_indices.size());
+	for (size_t k = 0; k < sphere_indices.size(); k++)
+	{
+		const std::shared_ptr<fcl::CollisionObjectf> coll_object { env->getCollObject(sphere_indices[k]) };
+		spheres.col(k) << coll_object->getTranslation(), 
+						  static_cast<const fcl::Sphere<float>*>(coll_object->collisionGeometry().get())->radius;
+	}
+
+	oriented_boxes.resize(6, oriented_box_indices.size());
+	oriented_box_rotations.resize(oriented_box_indices.size());
+	oriented_box_centers.resize(3, oriented_box_indices.size());
+	for (size_t k = 0; k < oriented_box_indices.size(); k++)
+	{
+		const std::shared_ptr<fcl::CollisionObjectf> coll_object { env->getCollObject(oriented_box_indices[k]) };
+		const Eigen::Vector3f half_dim { static_cast<const fcl::Box<float>*>(coll_object->collisionGeometry().get())->side / 2 };
+		oriented_boxes.col(k) << -half_dim, half_dim;
+		oriented_box_rotations[k] = coll_object->getRotation();
+		oriented_box_centers.col(k) = coll_object->getTranslation();
+	}
+
+	boxes.resize(6, num_boxes);
+	size_t idx_ground { 0 }, idx { num_ground_boxes };
+	for (size_t j = 0; j < num_obstacles; j++)
+	{
+		if (obstacle_types[j] == fcl::NODE_TYPE::GEOM_BOX && !obstacle_is_oriented[j])
+			boxes.col(obstacle_is_ground[j] ? idx_ground++ : idx++) = obstacle_bounds.col(j);
+	}
+	
+	broad_phase_threshold = RealVectorSpaceConfig::BROAD_PHASE_THRESHOLD;
+	use_grid = (broad_phase_threshold > 0 && boxes.cols() - num_ground_boxes >= broad_phase_threshold);
+	if (use_grid)
+		buildObstacleGrid();
 
-    return true;
+	obstacles_env = env;
+	obstacles_version = env->getVersion();
+}
+
+// Build a uniform grid over the AABB of all non-ground boxes, where the cell size is chosen such that 
+// there is about one box per cell. Each box is registered in all cells that its AABB overlaps.
+void base::RealVectorSpace::buildObstacleGrid()
+{
+	const size_t num { boxes.cols() - num_ground_boxes };
+	const size_t max_dim { 64 };	// Maximal number of cells per axis
+	grid_min = boxes.block(0, num_ground_boxes, 3, num).rowwise().minCoeff();
+	Eigen::Array3f extent { (boxes.block(3, num_ground_boxes, 3, num).rowwise().maxCoeff() - grid_min).max(1e-3) };
+	float cell_size { std::cbrt(extent.prod() / num) };
+	
+	grid_dims = (extent / cell_size).ceil().cast<int>().max(1).min(max_dim);
+	grid_cell_size = extent / grid_dims.cast<float>();
+	grid_cell_starts.assign(grid_dims.prod() + 1, 0);
+	grid_stamps.assign(boxes.cols(), 0);
+	grid_query = 0;
+
+	// Count boxes in each cell, and then fill them
+	for (size_t pass = 0; pass < 2; pass++)
+	{
+		if (pass == 1)
+		{
+			for (size_t c = 1; c < grid_cell_starts.size(); c++)
+				grid_cell_starts[c] += grid_cell_starts[c-1];
+
+			grid_boxes.resize(grid_cell_starts.back());
+		}
+
+		for (size_t j = num_ground_boxes; j < size_t(boxes.cols()); j++)
+		{
+			Eigen::Array3i lower { ((boxes.col(j).head(3) - grid_min) / grid_cell_size).floor().cast<int>().max(0).min(grid_dims - 1) };
+			Eigen::Array3i upper { ((boxes.col(j).tail(3) - grid_min) / grid_cell_size).floor().cast<int>().max(0).min(grid_dims - 1) };
+			for (int x = lower(0); x <= upper(0); x++)
+			{
+				for (int y = lower(1); y <= upper(1); y++)
+				{
+					for (int z = lower(2); z <= upper(2); z++)
+					{
+						size_t c { size_t((x * grid_dims(1) + y) * grid_dims(2) + z) };
+						if (pass == 0)
+							grid_cell_starts[c]++;
+						else
+							grid_boxes[--grid_cell_starts[c]] = j;
+					}
+				}
+			}
+		}
+	}
+}
+
+// Check collision between capsule (determined with line segment AB and 'radius') and non-ground boxes,
+// where only boxes from grid cells overlapping the AABB of the capsule are considered.
+// Each candidate box is first checked (exactly as in 'collisionCapsuleToBox') whether the capsule is on the outer side of some face.
+bool base::RealVectorSpace::collisionCapsuleToGridBoxes(const Eigen::Vector3f &A, const Eigen::Vector3f &B, float radius)
+{
+	const float padding { 1e-3 };	// Cells are enlarged due to rounding errors
+	const Eigen::Array3f AB_min { A.cwiseMin(B).array() };
+	const Eigen::Array3f AB_max { A.cwiseMax(B).array() };
+	const Eigen::Array3i lower { ((AB_min - (radius + padding) - grid_min) / grid_cell_size).floor().cast<int>().max(0).min(grid_dims - 1) };
+	const Eigen::Array3i upper { ((AB_max + (radius + padding) - grid_min) / grid_cell_size).floor().cast<int>().max(0).min(grid_dims - 1) };
+	grid_query++;
+
+	for (int x = lower(0); x <= upper(0); x++)
+	{
+		for (int y = lower(1); y <= upper(1); y++)
+		{
+			for (int z = lower(2); z <= upper(2); z++)
+			{
+				size_t c { size_t((x * grid_dims(1) + y) * grid_dims(2) + z) };
+				for (size_t idx = grid_cell_starts[c]; idx < grid_cell_starts[c+1]; idx++)
+				{
+					size_t j { grid_boxes[idx] };
+					if (grid_stamps[j] == grid_query)
+						continue;
+					
+					grid_stamps[j] = grid_query;
+					if ((AB_max < boxes.col(j).head(3) - radius).any() || (AB_min > boxes.col(j).tail(3) + radius).any())
+						continue;
+
+					obs_scratch = boxes.col(j);
+					if (collisionCapsuleToBox(A, B, radius, obs_scratch))
+						return true;
+				}
+			}
+		}
+	}
+
+	return false;
 }
 
 /// @brief Compute a minimal distance from the robot in configuration 'q' to obstacles using methods from 'CollisionAndDistance' class.
@@ -321,51 +694,91 @@ float base::RealVectorSpace::computeDistance(const std::shared_ptr<base::State>
 	if (!compute_again && q->getDistance() > 0 && q->getIsRealDistance())
 		return q->getDistance();
 
+	return computeDistanceThresholded(q, 0);
+}
+
+/// @brief Check whether a minimal distance from the robot in configuration 'q' to obstacles is greater than 'd_threshold'.
+/// The computation terminates as soon as some robot's link is found to be within 'd_threshold' from some obstacle.
+/// If the distance is greater than 'd_threshold', 'd_c', 'd_c_profile' and 'nearest_points' are set for 'q' 
+/// as in 'computeDistance', so they can be further used without computing them again.
+/// @param q Configuration of the robot.
+/// @param d_threshold Distance threshold.
+/// @return True if the distance is greater than 'd_threshold', and false otherwise.
+bool base::RealVectorSpace::isDistanceGreater(const std::shared_ptr<base::State> q, float d_threshold)
+{
+	if (q->getDistance() > 0 && q->getIsRealDistance())
+		return q->getDistance() > d_threshold;
+
+	return computeDistanceThresholded(q, d_threshold) > d_threshold;
+}
+
+/// @brief Compute a minimal distance from the robot in configuration 'q' to obstacles, which terminates as soon as 
+/// a distance from some robot's link to some obstacle is not greater than 'd_threshold'.
+/// If 'RealVectorSpaceConfig::USE_DISTANCE_LOWER_BOUND' is true, a distance to the box obstacle is not computed 
+/// if its lower bound exceeds the current minimal distance of the link or the obstacle tolerance 'min_dist_tol'. 
+/// Instead, points of a plane separating them are stored as nearest points, which keeps 'computeDistanceUnderestimation' conservative.
+/// @param q Configuration of the robot.
+/// @param d_threshold Distance threshold (non-negative).
+/// @return Minimal distance from the robot in configuration 'q' to obstacles if it is greater than 'd_threshold'.
+/// Otherwise, some distance not greater than 'd_threshold' is returned, and 'q' is updated only if the collision occurs.
+float base::RealVectorSpace::computeDistanceThresholded(const std::shared_ptr<base::State> q, float d_threshold)
+{
 	float d_c_temp {};
 	float d_c { INFINITY };
 	std::vector<float> d_c_profile(robot->getNumLinks(), 0);
 	std::shared_ptr<std::vector<Eigen::MatrixXf>> nearest_points { std::make_shared<std::vector<Eigen::MatrixXf>>
 		(env->getNumObjects(), Eigen::MatrixXf(6, robot->getNumLinks())) };
-	std::shared_ptr<Eigen::MatrixXf> nearest_pts { std::make_shared<Eigen::MatrixXf>(3, 2) };
+	base::NearestPoints nearest_pts {};
 	std::shared_ptr<Eigen::MatrixXf> skeleton { robot->computeSkeleton(q) };
+	updateObstacles();
 
 	for (size_t i = 0; i < robot->getNumLinks(); i++)
 	{
 		d_c_profile[i] = INFINITY;
     	for (size_t j = 0; j < env->getNumObjects(); j++)
 		{
-			if (env->getObject(j)->getLabel() == "ground" && i < robot->getGroundIncluded())
+			if (obstacle_is_ground[j] && i < robot->getGroundIncluded())
 			{
 				d_c_temp = INFINITY;
-				nearest_pts->col(0) << 0, 0, 0; 			// Robot nearest point
-				nearest_pts->col(1) << 0, 0, -INFINITY;		// Obstacle nearest point
+				nearest_pts.col(0) << 0, 0, 0; 			// Robot nearest point
+				nearest_pts.col(1) << 0, 0, -INFINITY;		// Obstacle nearest point
 			}
-            else if (env->getCollObject(j)->getNodeType() == fcl::NODE_TYPE::GEOM_BOX)
+            else if (obstacle_types[j] == fcl::NODE_TYPE::GEOM_BOX)
 			{
-				fcl::AABB AABB { env->getCollObject(j)->getAABB() };
-				Eigen::VectorXf obs(6);
-				obs << AABB.min_[0], AABB.min_[1], AABB.min_[2], AABB.max_[0], AABB.max_[1], AABB.max_[2];
-                tie(d_c_temp, nearest_pts) = distanceCapsuleToBox(skeleton->col(i), skeleton->col(i+1), robot->getCapsuleRadius(i), obs);
+				obs_scratch = obstacle_bounds.col(j);
+				if (RealVectorSpaceConfig::USE_DISTANCE_LOWER_BOUND && 
+					distanceCapsuleToBoxLowerBound(skeleton->col(i), skeleton->col(i+1), robot->getCapsuleRadius(i), obs_scratch, nearest_pts) 
+					> std::min(d_c_profile[i], obstacle_min_dist_tols(j)))
+					d_c_temp = INFINITY;	// Real distance cannot decrease 'd_c_profile[i]'
+				else if (obstacle_is_oriented[j])
+				{
+					const size_t k { obstacle_packed_idx[j] };
+					obs_scratch = oriented_boxes.col(k);
+					d_c_temp = distanceCapsuleToOrientedBox(skeleton->col(i), skeleton->col(i+1), robot->getCapsuleRadius(i), 
+						oriented_box_rotations[k], oriented_box_centers.col(k), obs_scratch, nearest_pts);
+				}
+				else
+					d_c_temp = distanceCapsuleToBox(skeleton->col(i), skeleton->col(i+1), robot->getCapsuleRadius(i), obs_scratch, nearest_pts);
 				
 				// std::cout << "(i, j) = (" << i << ", " << j << "). " << std::endl;
 				// std::cout << "Distance:    " << d_c_temp << std::endl;
 				// if (nearest_pts != nullptr)
 				// {
-				// 	std::cout << "Nearest point link:    " << nearest_pts->col(0).transpose() << std::endl;
-				// 	std::cout << "Nearest point obs:     " << nearest_pts->col(1).transpose() << std::endl;
+				// 	std::cout << "Nearest point link:    " << nearest_pts.col(0).transpose() << std::endl;
+				// 	std::cout << "Nearest point obs:     " << nearest_pts.col(1).transpose() << std::endl;
 				// }
 				// std::cout << "r(i): " << robot->getCapsuleRadius(i) << std::endl;
 				// std::cout << "skeleton(i):   " << skeleton->col(i).transpose() << std::endl;
 				// std::cout << "skeleton(i+1): " << skeleton->col(i+1).transpose() << std::endl;
 				// std::cout << "-------------------------------------------------------------" << std::endl;
             }
-			else if (env->getCollObject(j)->getNodeType() == fcl::NODE_TYPE::GEOM_SPHERE)
+			else if (obstacle_types[j] == fcl::NODE_TYPE::GEOM_SPHERE)
 			{
-				Eigen::VectorXf obs(4); 	// TODO
-                tie(d_c_temp, nearest_pts) = distanceCapsuleToSphere(skeleton->col(i), skeleton->col(i+1), robot->getCapsuleRadius(i), obs);
+				sphere_scratch = spheres.col(obstacle_packed_idx[j]);
+                d_c_temp = distanceCapsuleToSphere(skeleton->col(i), skeleton->col(i+1), robot->getCapsuleRadius(i), sphere_scratch, nearest_pts);
             }
 
-			if (d_c_temp > env->getObject(j)->getMinDistTol())
+			if (d_c_temp > obstacle_min_dist_tols(j))
 				d_c_temp = INFINITY;
 
 			d_c_profile[i] = std::min(d_c_profile[i], d_c_temp);
@@ -377,9 +790,11 @@ float base::RealVectorSpace::computeDistance(const std::shared_ptr<base::State>
 				q->setNearestPoints(nullptr);
 				return 0;
 			}
+			else if (d_c_profile[i] <= d_threshold)
+				return d_c_profile[i];
 			
-			// 'nearest_pts->col(0)' is robot nearest point, and 'nearest_pts->col(1)' is obstacle nearest point
-			nearest_points->at(j).col(i) << nearest_pts->col(0), nearest_pts->col(1);
+			// 'nearest_pts.col(0)' is robot nearest point, and 'nearest_pts.col(1)' is obstacle nearest point
+			nearest_points->at(j).col(i) << nearest_pts.col(0), nearest_pts.col(1);
         }
 		d_c = std::min(d_c, d_c_profile[i]);
     }
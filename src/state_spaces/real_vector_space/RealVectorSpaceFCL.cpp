@@ -8,40 +8,129 @@ base::RealVectorSpaceFCL::RealVectorSpaceFCL(size_t num_dimensions_, const std::
 	setStateSpaceType(base::StateSpaceType::RealVectorSpaceFCL);
 	collision_manager_robot = std::make_shared<fcl::DynamicAABBTreeCollisionManagerf>();
 	collision_manager_env = std::make_shared<fcl::DynamicAABBTreeCollisionManagerf>();
+	env_manager_env = nullptr;
+	env_manager_version = std::numeric_limits<size_t>::max();
+
+	for (size_t i = 0; i < robot->getNumLinks(); i++)
+	{
+		collision_manager_robot->registerObject(robot->getLinks()[i].get());
+		link_indices[robot->getLinks()[i].get()] = i;
+	}
+	collision_manager_robot->setup();
 }
 
-bool base::RealVectorSpaceFCL::isValid(const std::shared_ptr<base::State> q)
+// Set the robot in the configuration 'q' and update 'collision_manager_robot' incrementally.
+// 'collision_manager_env' is built again only if the environment (or its version) is changed.
+void base::RealVectorSpaceFCL::updateCollisionManagers(const std::shared_ptr<base::State> q)
 {
-	robot->setState(q);	
-	fcl::DefaultCollisionData<float> collision_data {};
+	robot->setState(q);
+	collision_manager_robot->update();
+	updateObstacles();
 
-	for (size_t i = 0; i < robot->getNumLinks(); i++)
-	{	
-		for (size_t j = 0; j < env->getNumObjects(); j++)
-		{
-			if (env->getObject(j)->getLabel() == "ground" && i < robot->getGroundIncluded())
-				continue;
-			else
-			{
-				collision_manager_robot->clear();
-				collision_manager_env->clear();
-				collision_manager_robot->registerObject(robot->getLinks()[i].get());
-				collision_manager_env->registerObject(env->getCollObject(j).get());
-				collision_manager_robot->setup();
-				collision_manager_env->setup();
-
-				collision_manager_robot->collide(collision_manager_env.get(), &collision_data, fcl::DefaultCollisionFunction);
-				if (collision_data.result.isCollision())
-					return false;
-			}			
-		}
+	if (env_manager_env == env && env_manager_version == env->getVersion())
+		return;
+
+	collision_manager_env->clear();
+	obstacle_indices.clear();
+	for (size_t j = 0; j < env->getNumObjects(); j++)
+	{
+		collision_manager_env->registerObject(env->getCollObject(j).get());
+		obstacle_indices[env->getCollObject(j).get()] = j;
+	}
+	collision_manager_env->setup();
+	env_manager_env = env;
+	env_manager_version = env->getVersion();
+}
+
+// Sort the pair of objects 'o1' and 'o2' reported by FCL into robot's link 'link' and obstacle 'obs', and get their indices.
+// Return false if the pair should not be checked (i.e., when ground is not considered for the link).
+bool base::RealVectorSpaceFCL::getPairIndices(fcl::CollisionObjectf *o1, fcl::CollisionObjectf *o2, fcl::CollisionObjectf *&link, 
+											  fcl::CollisionObjectf *&obs, size_t &link_idx, size_t &obs_idx) const
+{
+	auto it { link_indices.find(o1) };
+	link = o1;
+	obs = o2;
+	if (it == link_indices.end())
+	{
+		it = link_indices.find(o2);
+		std::swap(link, obs);
 	}
+
+	link_idx = it->second;
+	obs_idx = obstacle_indices.at(obs);
+	return !(obstacle_is_ground[obs_idx] && link_idx < robot->getGroundIncluded());
+}
+
+bool base::RealVectorSpaceFCL::collisionCallback(fcl::CollisionObjectf *o1, fcl::CollisionObjectf *o2, void *data)
+{
+	CollisionData *collision_data { static_cast<CollisionData*>(data) };
+	fcl::CollisionObjectf *link {}, *obs {};
+	size_t i {}, j {};
+	if (!collision_data->ss->getPairIndices(o1, o2, link, obs, i, j))
+		return false;
+
+	fcl::CollisionRequest<float> request {};
+	fcl::CollisionResult<float> result {};
+	fcl::collide(link, obs, request, result);
+	collision_data->is_collision = result.isCollision();
+	
+	return collision_data->is_collision;	// Terminate if the collision occurs
+}
+
+bool base::RealVectorSpaceFCL::distanceCallback(fcl::CollisionObjectf *o1, fcl::CollisionObjectf *o2, void *data, [[maybe_unused]] float &dist)
+{
+	DistanceData *distance_data { static_cast<DistanceData*>(data) };
+	fcl::CollisionObjectf *link {}, *obs {};
+	size_t i {}, j {};
+	if (!distance_data->ss->getPairIndices(o1, o2, link, obs, i, j))
+		return false;
+
+	distance_data->result.clear();
+	fcl::distance(link, obs, distance_data->request, distance_data->result);
+
+	float d_c { distance_data->result.min_distance };
+	if (d_c > distance_data->ss->obstacle_min_dist_tols(j))
+		d_c = INFINITY;
+	
+	distance_data->d_c_profile[i] = std::min(distance_data->d_c_profile[i], d_c);
+	distance_data->nearest_points->at(j).col(i) << distance_data->result.nearest_points[0], distance_data->result.nearest_points[1];
+	
+	// 'dist' is kept unchanged, so that the distances of all pairs are computed
+	return distance_data->d_c_profile[i] <= 0;		// Terminate if the collision occurs
+}
+
+// FCL needs the robot to be set in the configuration 'q_coord', so a temporary state is created.
+bool base::RealVectorSpaceFCL::isValid(const Eigen::VectorXf &q_coord)
+{
+	return isValid(getNewState(q_coord));
+}
+
+// FCL checks each configuration from the batch separately, since skeletons are not used.
+bool base::RealVectorSpaceFCL::isValidBatch(const robots::BatchSoA &q_coords, size_t num_configs)
+{
+	for (size_t n = 0; n < num_configs; n++)
+	{
+		q_coord_scratch = q_coords.col(n).matrix();
+		if (!isValid(q_coord_scratch))
+			return false;
+	}
+
 	return true;
 }
 
+bool base::RealVectorSpaceFCL::isValid(const std::shared_ptr<base::State> q)
+{
+	updateCollisionManagers(q);
+	CollisionData collision_data { this, false };
+	collision_manager_robot->collide(collision_manager_env.get(), &collision_data, collisionCallback);
+
+	return !collision_data.is_collision;
+}
+
 /// @brief Compute a minimal distance from the robot in configuration 'q' to obstacles using FCL library.
 /// In other words, compute a minimal distance from each robot's link in configuration 'q' to obstacles, 
 /// i.e., compute a distance profile function. 
+/// All pairs of robot's links and obstacles are handled within a single distance query between the collision managers.
 /// Moreover, set 'd_c', 'd_c_profile', and corresponding 'nearest_points' for the configuation 'q'.
 /// @param q Configuration of the robot.
 /// @param compute_again If true, a new distance profile will be computed again! Default: false.
@@ -51,69 +140,49 @@ float base::RealVectorSpaceFCL::computeDistance(const std::shared_ptr<base::Stat
 	if (!compute_again && q->getDistance() > 0 && q->getIsRealDistance())
 		return q->getDistance();
 	
-	float d_c { INFINITY };
-	std::vector<float> d_c_profile(robot->getNumLinks(), 0);
-	std::shared_ptr<std::vector<Eigen::MatrixXf>> nearest_points { std::make_shared<std::vector<Eigen::MatrixXf>>
-		(env->getNumObjects(), Eigen::MatrixXf(6, robot->getNumLinks())) };
-	std::shared_ptr<Eigen::MatrixXf> nearest_pts { std::make_shared<Eigen::MatrixXf>(3, 2) };
-	fcl::DefaultDistanceData<float> distance_data;
-	robot->setState(q);
+	updateCollisionManagers(q);
+	DistanceData distance_data;
+	distance_data.ss = this;
+	distance_data.request.enable_nearest_points = true;
+	distance_data.d_c_profile = std::vector<float>(robot->getNumLinks(), INFINITY);
+	distance_data.nearest_points = std::make_shared<std::vector<Eigen::MatrixXf>>
+		(env->getNumObjects(), Eigen::MatrixXf(6, robot->getNumLinks()));
 	
-	for (size_t i = 0; i < robot->getNumLinks(); i++)
+	// Pairs which are not checked (i.e., ground with the first 'robot->getGroundIncluded()' links) get default nearest points
+	for (size_t j = 0; j < env->getNumObjects(); j++)
+	{
+		if (obstacle_is_ground[j])
+			distance_data.nearest_points->at(j).leftCols(robot->getGroundIncluded()).colwise() = 
+				(Eigen::VectorXf(6) << 0, 0, 0, 0, 0, -INFINITY).finished();	// Robot and obstacle nearest point
+	}
+
+	collision_manager_robot->distance(collision_manager_env.get(), &distance_data, distanceCallback);
+
+	const std::vector<float> &d_c_profile { distance_data.d_c_profile };
+	float d_c { *std::min_element(d_c_profile.begin(), d_c_profile.end()) };
+	if (d_c <= 0)		// The collision occurs
 	{
-		d_c_profile[i] = INFINITY;
-		for (size_t j = 0; j < env->getNumObjects(); j++)
-		{
-			if (env->getObject(j)->getLabel() == "ground" && i < robot->getGroundIncluded())
-			{
-				nearest_pts->col(0) << 0, 0, 0; 			// Robot nearest point
-				nearest_pts->col(1) << 0, 0, -INFINITY;		// Obstacle nearest point
-			}
-			else
-			{
-				collision_manager_robot->clear();
-				collision_manager_env->clear();
-				collision_manager_robot->registerObject(robot->getLinks()[i].get());
-				collision_manager_env->registerObject(env->getCollObject(j).get());
-				collision_manager_robot->setup();
-				collision_manager_env->setup();
-
-				distance_data.request.enable_nearest_points = true;
-				distance_data.result.clear();
-				collision_manager_robot->distance(collision_manager_env.get(), &distance_data, fcl::DefaultDistanceFunction);
-
-				if (distance_data.result.min_distance > env->getObject(j)->getMinDistTol())
-					distance_data.result.min_distance = INFINITY;
-
-				d_c_profile[i] = std::min(d_c_profile[i], distance_data.result.min_distance);
-				nearest_pts->col(0) = distance_data.result.nearest_points[0];
-				nearest_pts->col(1) = distance_data.result.nearest_points[1];
-
-				// LOG(INFO) << "(i, j) = (" << i << ", " << j << ")" << std::endl;
-				// LOG(INFO) << "d_c = " << distance_data.result.min_distance << std::endl;
-				// LOG(INFO) << "NP robot: " << nearest_pts->col(0).transpose() << std::endl;
-				// LOG(INFO) << "NP env:   " << nearest_pts->col(1).transpose() << std::endl;
-			}
-
-			if (d_c_profile[i] <= 0)		// The collision occurs
-            {
-				q->setDistance(0);
-				q->setDistanceProfile(d_c_profile);
-				q->setIsRealDistance(true);
-				q->setNearestPoints(nullptr);
-				return 0;
-			}
-			
-			// 'nearest_pts->col(0)' is robot nearest point, and 'nearest_pts->col(1)' is obstacle nearest point
-			nearest_points->at(j).col(i) << nearest_pts->col(0), nearest_pts->col(1);
-		}
-		d_c = std::min(d_c, d_c_profile[i]);
+		q->setDistance(0);
+		q->setDistanceProfile(d_c_profile);
+		q->setIsRealDistance(true);
+		q->setNearestPoints(nullptr);
+		return 0;
 	}
 	
 	q->setDistance(d_c);
 	q->setDistanceProfile(d_c_profile);
 	q->setIsRealDistance(true);
-	q->setNearestPoints(nearest_points);
+	q->setNearestPoints(distance_data.nearest_points);
 	
 	return d_c;
 }
+
+/// @brief Check whether a minimal distance from the robot in configuration 'q' to obstacles is greater than 'd_threshold'.
+/// Since FCL does not support early termination, the full distance profile is always computed.
+/// @param q Configuration of the robot.
+/// @param d_threshold Distance threshold.
+/// @return True if the distance is greater than 'd_threshold', and false otherwise.
+bool base::RealVectorSpaceFCL::isDistanceGreater(const std::shared_ptr<base::State> q, float d_threshold)
+{
+	return computeDistance(q, false) > d_threshold;
+}
@@ -1,5 +1,10 @@
 #include <gtest/gtest.h>
 #include "tests_realvectorspacestate.h"
+#include "tests_realvectorspace.h"
+#include "tests_tree.h"
+#include "tests_forward_kinematics.h"
+#include "tests_capsule_robot.h"
+#include "tests_planar_10dof.h"
 
 int main(int argc, char **argv) 
 {
@@ -0,0 +1,67 @@
+#include "xArm6.h"
+#include "CapsuleRobot.h"
+#include "RealVectorSpaceState.h"
+#include "tests_common.h"
+#include <Eigen/Dense>
+
+// The generic capsule robot read from 'xarm6_capsules.yaml' must be equivalent to the hand-coded xArm6 robot
+TEST(CapsuleRobotTest, testIsEquivalentToXArm6)
+{
+    const std::string project_path = getProjectPath();
+    std::shared_ptr<robots::xArm6> robot = std::make_shared<robots::xArm6>(project_path + "/data/xarm6/xarm6.urdf");
+    std::shared_ptr<robots::CapsuleRobot> capsule_robot = std::make_shared<robots::CapsuleRobot>
+        (project_path + "/data/xarm6/xarm6.urdf", project_path + "/data/xarm6/xarm6_capsules.yaml");
+    robot->setCapsulesRadius({0.047, 0.12, 0.11, 0.09, 0.05, 0.0380});     // The same as in "xarm6_capsules.yaml"
+    robot->setSelfCollisionChecking(true);
+    capsule_robot->setSelfCollisionChecking(true);
+
+    ASSERT_EQ(capsule_robot->getNumDOFs(), robot->getNumDOFs());
+    ASSERT_EQ(capsule_robot->getNumLinks(), robot->getNumLinks());
+    for (size_t i = 0; i < robot->getNumDOFs(); i++)
+    {
+        ASSERT_FLOAT_EQ(capsule_robot->getLimits()[i].first, robot->getLimits()[i].first);
+        ASSERT_FLOAT_EQ(capsule_robot->getLimits()[i].second, robot->getLimits()[i].second);
+    }
+    for (size_t i = 0; i < robot->getNumLinks(); i++)
+        ASSERT_FLOAT_EQ(capsule_robot->getCapsuleRadius(i), robot->getCapsuleRadius(i));
+
+    std::srand(0);
+    size_t num_self_colliding = 0;
+    for (size_t k = 0; k < 1000; k++)
+    {
+        Eigen::VectorXf rand = Eigen::VectorXf::Random(robot->getNumDOFs());
+        for (size_t i = 0; i < robot->getNumDOFs(); i++)
+            rand(i) = ((robot->getLimits()[i].second - robot->getLimits()[i].first) * rand(i) 
+                      + robot->getLimits()[i].first + robot->getLimits()[i].second) / 2;
+        std::shared_ptr<base::State> q = std::make_shared<base::RealVectorSpaceState>(rand);
+        std::shared_ptr<base::State> q_capsule = std::make_shared<base::RealVectorSpaceState>(rand);
+
+        Eigen::MatrixXf skeleton = *robot->computeSkeleton(q);
+        Eigen::MatrixXf skeleton_capsule = *capsule_robot->computeSkeleton(q_capsule);
+        ASSERT_EQ(skeleton_capsule.cols(), skeleton.cols());
+        ASSERT_LT((skeleton_capsule - skeleton).cwiseAbs().maxCoeff(), 1e-5);
+
+        // Joints 1, 4 and 6 use the distance to the joint axis in both robots. Otherwise, xArm6 uses the distance 
+        // to the joint origin, which cannot be less than the distance to the joint axis.
+        Eigen::MatrixXf R = *robot->computeEnclosingRadii(q);
+        Eigen::MatrixXf R_capsule = *capsule_robot->computeEnclosingRadii(q_capsule);
+        ASSERT_EQ(R_capsule.rows(), R.rows());
+        ASSERT_EQ(R_capsule.cols(), R.cols());
+        for (Eigen::Index i = 0; i < R.rows(); i++)
+        {
+            for (Eigen::Index j = 0; j < R.cols(); j++)
+            {
+                ASSERT_EQ(R_capsule(i, j) == 0, R(i, j) == 0);
+                if (i == 0 || i == 3 || i == 5)
+                    ASSERT_NEAR(R_capsule(i, j), R(i, j), 1e-5);
+                else
+                    ASSERT_LE(R_capsule(i, j), R(i, j) + 1e-5);
+            }
+        }
+
+        bool self_collision = robot->checkSelfCollision(q);
+        ASSERT_EQ(capsule_robot->checkSelfCollision(q_capsule), self_collision);
+        num_self_colliding += self_collision;
+    }
+    ASSERT_GT(num_self_colliding, 0);   // Both results are checked
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#ifndef RPMPL_TESTS_COMMON_H
+#define RPMPL_TESTS_COMMON_H
+
+#include "AbstractRobot.h"
+#include "Environment.h"
+#include <Eigen/Dense>
+
+// Path of the project root, where 'data' is located
+inline std::string getProjectPath()
+{
+    std::string project_path(__FILE__);
+    for (size_t i = 0; i < 2; i++)     // This depends on how deep is this file located
+        project_path = project_path.substr(0, project_path.find_last_of("/\\"));
+    
+    return project_path;
+}
+
+// Environment of the scenario 'scenario_test' for 'planar_2dof' without obstacles
+inline std::shared_ptr<env::Environment> getEmptyEnvironment()
+{
+    std::shared_ptr<env::Environment> env = std::make_shared<env::Environment>
+        ("/data/planar_2dof/scenario_test/scenario_test.yaml", getProjectPath());
+    env->removeAllObjects();
+    return env;
+}
+
+// Planar robot with one revolute joint about the z-axis in the origin, 
+// whose only link is a capsule with the length 'length' and the radius 'radius'
+class Planar1DOFTestRobot : public robots::AbstractRobot
+{
+public:
+    Planar1DOFTestRobot(float length_ = 1, float radius = 0.05) : length(length_)
+    {
+        type = "planar_1DOF_test";
+        num_DOFs = 1;
+        limits.emplace_back(-M_PI, M_PI);
+        links.emplace_back(std::make_unique<fcl::CollisionObjectf>
+            (std::make_shared<fcl::Capsulef>(radius, length), fcl::Transform3f::Identity()));
+        capsules_radius = {radius};
+        self_collision_checking = false;
+        gripper_length = 0;
+        ground_included = 0;
+    }
+
+    void setState(const std::shared_ptr<base::State> q) override { configuration = q; }
+    std::shared_ptr<std::vector<KDL::Frame>> computeForwardKinematics([[maybe_unused]] const std::shared_ptr<base::State> q) override 
+        { return nullptr; }
+    std::shared_ptr<base::State> computeInverseKinematics([[maybe_unused]] const KDL::Rotation &R, [[maybe_unused]] const KDL::Vector &p,
+        [[maybe_unused]] const std::shared_ptr<base::State> q_init = nullptr) override { return nullptr; }
+    
+    std::shared_ptr<Eigen::MatrixXf> computeSkeleton(const std::shared_ptr<base::State> q) override
+    {
+        std::shared_ptr<Eigen::MatrixXf> skeleton = std::make_shared<Eigen::MatrixXf>(3, 2);
+        computeSkeleton(q->getCoord(), *skeleton);
+        return skeleton;
+    }
+
+    void computeSkeleton(const Eigen::VectorXf &q_coord, Eigen::MatrixXf &skeleton) override
+    {
+        skeleton.resize(3, 2);
+        skeleton.col(0).setZero();
+        skeleton.col(1) << length * std::cos(q_coord(0)), length * std::sin(q_coord(0)), 0;
+    }
+
+    std::shared_ptr<Eigen::MatrixXf> computeEnclosingRadii([[maybe_unused]] const std::shared_ptr<base::State> q) override
+    {
+        std::shared_ptr<Eigen::MatrixXf> R = std::make_shared<Eigen::MatrixXf>(Eigen::MatrixXf::Zero(1, 2));
+        (*R)(0, 1) = length + capsules_radius[0];
+        return R;
+    }
+
+    bool checkSelfCollision([[maybe_unused]] const std::shared_ptr<base::State> q1, 
+                            [[maybe_unused]] std::shared_ptr<base::State> &q2) override { return false; }
+    bool checkSelfCollision([[maybe_unused]] const std::shared_ptr<base::State> q) override { return false; }
+
+private:
+    float length;
+};
+
+#endif //RPMPL_TESTS_COMMON_H
\ No newline at end of file
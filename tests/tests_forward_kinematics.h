@@ -0,0 +1,93 @@
+#include "ForwardKinematics.h"
+#include <Eigen/Dense>
+
+TEST(ForwardKinematicsTest, testIsEquivalentToKDL)
+{
+    // Random serial chain with revolute, prismatic and fixed joints, whose root is not the tree root
+    std::srand(0);
+    KDL::Tree tree("world");
+    tree.addSegment(KDL::Segment("base", KDL::Joint(KDL::Joint::None), 
+                                 KDL::Frame(KDL::Rotation::RPY(0.1, 0.2, 0.3), KDL::Vector(0.1, 0, 0.2))), "world");
+    std::string parent = "base";
+    for (size_t i = 0; i < 6; i++)
+    {
+        Eigen::Vector3d origin = Eigen::Vector3d::Random();
+        Eigen::Vector3d axis = Eigen::Vector3d::Random().normalized();
+        Eigen::Vector3d rpy = M_PI * Eigen::Vector3d::Random();
+        Eigen::Vector3d tip = Eigen::Vector3d::Random();
+        KDL::Joint joint("joint" + std::to_string(i), KDL::Vector(origin(0), origin(1), origin(2)), 
+                         KDL::Vector(axis(0), axis(1), axis(2)), i == 3 ? KDL::Joint::TransAxis : KDL::Joint::RotAxis);
+        KDL::Frame f_tip(KDL::Rotation::RPY(rpy(0), rpy(1), rpy(2)), KDL::Vector(tip(0), tip(1), tip(2)));
+        tree.addSegment(KDL::Segment("link" + std::to_string(i), joint, f_tip), parent);
+        parent = "link" + std::to_string(i);
+    }
+    tree.addSegment(KDL::Segment("tool", KDL::Joint(KDL::Joint::None), KDL::Frame(KDL::Vector(0, 0, 0.1))), parent);
+
+    robots::ForwardKinematics fk_solver(tree, "base", "tool");
+    ASSERT_EQ(fk_solver.getNumSegments(), 7);
+    ASSERT_EQ(fk_solver.getNumJoints(), 6);
+
+    KDL::Chain chain;
+    tree.getChain("base", "tool", chain);
+    KDL::TreeFkSolverPos_recursive tree_fk_solver(tree);
+    KDL::JntArray joint_pos(6);
+    KDL::Frame frame_kdl;
+    std::vector<KDL::Frame> frames(7);
+    for (size_t k = 0; k < 100; k++)
+    {
+        Eigen::VectorXf q = M_PI * Eigen::VectorXf::Random(6);
+        joint_pos.data = q.cast<double>();
+        fk_solver.compute(q, frames);
+        for (size_t i = 0; i < frames.size(); i++)
+        {
+            tree_fk_solver.JntToCart(joint_pos, frame_kdl, chain.getSegment(i).getName());
+            for (size_t j = 0; j < 9; j++)
+                ASSERT_NEAR(frames[i].M.data[j], frame_kdl.M.data[j], 1e-4);
+            for (size_t j = 0; j < 3; j++)
+                ASSERT_NEAR(frames[i].p.data[j], frame_kdl.p.data[j], 1e-4);
+        }
+    }
+}
+
+TEST(ForwardKinematicsTest, testBatchIsEquivalentToSingle)
+{
+    std::srand(0);
+    KDL::Tree tree("base");
+    std::string parent = "base";
+    for (size_t i = 0; i < 5; i++)
+    {
+        Eigen::Vector3d origin = Eigen::Vector3d::Random();
+        Eigen::Vector3d axis = Eigen::Vector3d::Random().normalized();
+        Eigen::Vector3d rpy = M_PI * Eigen::Vector3d::Random();
+        Eigen::Vector3d tip = Eigen::Vector3d::Random();
+        KDL::Joint joint("joint" + std::to_string(i), KDL::Vector(origin(0), origin(1), origin(2)), 
+                         KDL::Vector(axis(0), axis(1), axis(2)), i == 2 ? KDL::Joint::TransAxis : KDL::Joint::RotAxis);
+        KDL::Frame f_tip(KDL::Rotation::RPY(rpy(0), rpy(1), rpy(2)), KDL::Vector(tip(0), tip(1), tip(2)));
+        tree.addSegment(KDL::Segment("link" + std::to_string(i), joint, f_tip), parent);
+        parent = "link" + std::to_string(i);
+    }
+    tree.addSegment(KDL::Segment("tool", KDL::Joint(KDL::Joint::None), KDL::Frame(KDL::Vector(0, 0, 0.1))), parent);
+
+    robots::ForwardKinematics fk_solver(tree, "base", "tool");
+    std::vector<KDL::Frame> frames(6);
+    robots::BatchSoA frames_batch;
+    for (size_t num_configs : { 1, 8, 13 })     // Including a batch which is not a multiple of the chunk size
+    {
+        robots::BatchSoA q_coords = M_PI * robots::BatchSoA::Random(5, num_configs);
+        fk_solver.computeBatch(q_coords, frames_batch, frames.size());
+        ASSERT_EQ(frames_batch.rows(), Eigen::Index(12 * frames.size()));
+        ASSERT_EQ(frames_batch.cols(), Eigen::Index(num_configs));
+        
+        for (size_t n = 0; n < num_configs; n++)
+        {
+            fk_solver.compute(q_coords.col(n).matrix(), frames);
+            for (size_t i = 0; i < frames.size(); i++)
+            {
+                for (size_t j = 0; j < 9; j++)
+                    ASSERT_NEAR(frames_batch(12*i + j, n), frames[i].M.data[j], 1e-4);
+                for (size_t j = 0; j < 3; j++)
+                    ASSERT_NEAR(frames_batch(12*i + 9 + j, n), frames[i].p.data[j], 1e-4);
+            }
+        }
+    }
+}
\ No newline at end of file
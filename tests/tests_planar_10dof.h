@@ -0,0 +1,47 @@
+#include "Planar10DOF.h"
+#include "RealVectorSpaceState.h"
+#include "tests_common.h"
+#include <Eigen/Dense>
+
+// Links of 'planar_10dof' are 0.2 [m] long capsules with the radius 0.025 [m]
+TEST(Planar10DOFTest, testSelfCollision)
+{
+    std::shared_ptr<robots::Planar10DOF> robot = std::make_shared<robots::Planar10DOF>
+        (getProjectPath() + "/data/planar_10dof/planar_10dof.urdf");
+    ASSERT_TRUE(robot->getSelfCollisionChecking());
+    ASSERT_EQ(robot->getSelfCollisionPairs().size(), 36);   // All pairs of non-adjacent links
+
+    // Straight robot
+    Eigen::VectorXf q_straight_coord = Eigen::VectorXf::Zero(10);
+    std::shared_ptr<base::State> q_straight = std::make_shared<base::RealVectorSpaceState>(q_straight_coord);
+    ASSERT_FALSE(robot->checkSelfCollision(q_straight));
+
+    // The third link is folded back over the first one
+    Eigen::VectorXf q_folded_coord = Eigen::VectorXf::Zero(10);
+    q_folded_coord(1) = 2.5;
+    q_folded_coord(2) = 2.5;
+    std::shared_ptr<base::State> q_folded = std::make_shared<base::RealVectorSpaceState>(q_folded_coord);
+    ASSERT_TRUE(robot->checkSelfCollision(q_folded));
+
+    // Edge without self-collision remains unchanged
+    Eigen::VectorXf q_bent_coord = Eigen::VectorXf::Zero(10);
+    q_bent_coord(1) = 1;
+    std::shared_ptr<base::State> q_bent = std::make_shared<base::RealVectorSpaceState>(q_bent_coord);
+    ASSERT_FALSE(robot->checkSelfCollision(q_straight, q_bent));
+    ASSERT_EQ(q_bent->getCoord(), q_bent_coord);
+
+    // Edge across the fold is cut before the first self-collision
+    std::shared_ptr<base::State> q2 = q_folded;
+    ASSERT_TRUE(robot->checkSelfCollision(q_straight, q2));
+    ASSERT_NE(q2, q_folded);
+    ASSERT_FALSE(robot->checkSelfCollision(q2));
+    ASSERT_LT((q2->getCoord() - q_straight_coord).norm(), (q_folded_coord - q_straight_coord).norm());
+    for (float t = 0; t <= 1; t += 0.01)
+    {
+        Eigen::VectorXf q_coord = q_straight_coord + t * (q2->getCoord() - q_straight_coord);
+        ASSERT_FALSE(robot->checkSelfCollision(std::make_shared<base::RealVectorSpaceState>(q_coord)));
+    }
+
+    robot->setSelfCollisionChecking(false);
+    ASSERT_FALSE(robot->checkSelfCollision(q_folded));
+}
\ No newline at end of file
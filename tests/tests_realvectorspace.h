@@ -0,0 +1,288 @@
+#include "RealVectorSpaceN.h"
+#include "tests_common.h"
+#include <Eigen/Dense>
+
+TEST(RealVectorSpaceTest, testFixedSizeSpaceIsEquivalent)
+{
+    std::shared_ptr<base::StateSpace> ss = std::make_shared<base::RealVectorSpace>(6, nullptr, nullptr);
+    std::shared_ptr<base::StateSpace> ss_fixed = std::make_shared<base::RealVectorSpaceN<6>>(nullptr, nullptr);
+    ASSERT_EQ(ss_fixed->num_dimensions, 6);
+    ASSERT_EQ(ss_fixed->getStateSpaceType(), base::StateSpaceType::RealVectorSpace);
+
+    for (size_t i = 0; i < 100; i++)
+    {
+        std::shared_ptr<base::State> q1 = ss->getNewState(Eigen::VectorXf::Random(6));
+        std::shared_ptr<base::State> q2 = ss->getNewState(Eigen::VectorXf::Random(6));
+        ASSERT_FLOAT_EQ(ss_fixed->getNorm(q1, q2), ss->getNorm(q1, q2));
+        ASSERT_TRUE(ss_fixed->isEqual(ss_fixed->interpolateEdge(q1, q2, 0.1), ss->interpolateEdge(q1, q2, 0.1)));
+        ASSERT_TRUE(ss_fixed->isEqual(ss_fixed->interpolateEdge(q1, q1, 0.1)->getCoord(), q1->getCoord()));
+    }
+
+    const Eigen::VectorXf metric_weights = Eigen::VectorXf::LinSpaced(6, 0.5, 2);
+    ss->setMetricWeights(metric_weights);
+    ss_fixed->setMetricWeights(metric_weights);
+    std::shared_ptr<base::State> q1 = ss->getNewState(Eigen::VectorXf::Random(6));
+    std::shared_ptr<base::State> q2 = ss->getNewState(Eigen::VectorXf::Random(6));
+    ASSERT_FLOAT_EQ(ss_fixed->getNorm(q1, q2), ss->getNorm(q1, q2));
+
+    // Both overloads of 'isEqual' use the weighted metric
+    Eigen::VectorXf q3_coord = q1->getCoord();
+    q3_coord(0) += 1.5 * RealVectorSpaceConfig::EQUALITY_THRESHOLD;
+    std::shared_ptr<base::State> q3 = ss->getNewState(q3_coord);
+    for (std::shared_ptr<base::StateSpace> space : { ss, ss_fixed })
+    {
+        ASSERT_TRUE(space->isEqual(q1, q3));
+        ASSERT_TRUE(space->isEqual(q1->getCoord(), q3_coord));
+    }
+}
+
+TEST(RealVectorSpaceTest, testEdgeCheckOrder)
+{
+    for (size_t num_checks : {1, 2, 3, 10, 16})
+    {
+        for (base::EdgeCheckOrder order : {base::EdgeCheckOrder::Backward, base::EdgeCheckOrder::Forward, base::EdgeCheckOrder::Bisection})
+        {
+            std::vector<size_t> indices = base::RealVectorSpace::computeEdgeCheckOrder(num_checks, order);
+            ASSERT_EQ(indices.size(), num_checks);
+            std::sort(indices.begin(), indices.end());
+            for (size_t k = 1; k <= num_checks; k++)
+                ASSERT_EQ(indices[k-1], k);
+        }
+    }
+
+    std::vector<size_t> indices = base::RealVectorSpace::computeEdgeCheckOrder(10, base::EdgeCheckOrder::Bisection);
+    ASSERT_EQ(indices, std::vector<size_t>({10, 5, 2, 7, 1, 3, 6, 8, 4, 9}));
+    indices = base::RealVectorSpace::computeEdgeCheckOrder(10, base::EdgeCheckOrder::Backward);
+    ASSERT_EQ(indices.front(), 10);
+    ASSERT_EQ(indices.back(), 1);
+}
+
+TEST(RealVectorSpaceTest, testCapsuleToBoxesIsEquivalent)
+{
+    Eigen::VectorXf obs(6);
+    for (size_t i = 0; i < 1000; i++)
+    {
+        const size_t num_boxes = 1 + i % 50;
+        base::BoxesSoA boxes(6, num_boxes);
+        for (size_t j = 0; j < num_boxes; j++)
+        {
+            Eigen::Array3f center = Eigen::Array3f::Random();
+            Eigen::Array3f half_size = 0.05 + 0.2 * Eigen::Array3f::Random().abs();
+            boxes.col(j) << center - half_size, center + half_size;
+        }
+        Eigen::Vector3f A = Eigen::Vector3f::Random();
+        Eigen::Vector3f B = Eigen::Vector3f::Random();
+        float radius = 0.1 * std::abs(Eigen::VectorXf::Random(1)(0));
+        size_t first = i % num_boxes;
+
+        bool collision = false;
+        for (size_t j = first; j < num_boxes && !collision; j++)
+        {
+            obs = boxes.col(j);
+            collision = base::CollisionAndDistance::collisionCapsuleToBox(A, B, radius, obs);
+        }
+        ASSERT_EQ(base::CollisionAndDistance::collisionCapsuleToBoxes(A, B, radius, boxes, first), collision);
+    }
+}
+
+TEST(RealVectorSpaceTest, testDistanceLowerBound)
+{
+    Eigen::VectorXf obs(6);
+    base::NearestPoints plane_pts;
+    for (size_t i = 0; i < 1000; i++)
+    {
+        Eigen::Array3f center = Eigen::Array3f::Random();
+        Eigen::Array3f half_size = 0.05 + 0.2 * Eigen::Array3f::Random().abs();
+        obs << center - half_size, center + half_size;
+        Eigen::Vector3f A = Eigen::Vector3f::Random();
+        Eigen::Vector3f B = Eigen::Vector3f::Random();
+        float radius = 0.1 * std::abs(Eigen::VectorXf::Random(1)(0));
+
+        float d_lower = base::CollisionAndDistance::distanceCapsuleToBoxLowerBound(A, B, radius, obs, plane_pts);
+        float d_c = std::get<0>(base::CollisionAndDistance::distanceCapsuleToBox(A, B, radius, obs));
+        ASSERT_LE(d_lower, d_c + 1e-5);
+        if (d_lower > 0)     // Distance to the separating plane is between the lower bound and the real distance
+        {
+            Eigen::Vector3f n = (plane_pts.col(0) - plane_pts.col(1)).normalized();
+            float d_plane = std::min((A - plane_pts.col(1)).dot(n), (B - plane_pts.col(1)).dot(n)) - radius;
+            ASSERT_GE(d_plane, d_lower - 1e-5);
+            ASSERT_LE(d_plane, d_c + 1e-5);
+        }
+    }
+}
+
+TEST(RealVectorSpaceTest, testCapsuleToSphere)
+{
+    Eigen::VectorXf obs(4);
+    base::NearestPoints nearest_pts;
+    for (size_t i = 0; i < 1000; i++)
+    {
+        obs << Eigen::Vector3f::Random(), 0.05 + 0.2 * std::abs(Eigen::VectorXf::Random(1)(0));
+        Eigen::Vector3f A = Eigen::Vector3f::Random();
+        Eigen::Vector3f B = (i % 10 == 0) ? A : Eigen::Vector3f::Random();
+        float radius = 0.1 * std::abs(Eigen::VectorXf::Random(1)(0));
+
+        // Distance from the sphere center to the line segment AB is approximated by sampling AB
+        float d_sampled = INFINITY;
+        for (size_t k = 0; k <= 1000; k++)
+            d_sampled = std::min(d_sampled, (A + (B - A) * (k / 1000.f) - obs.head(3)).norm());
+        d_sampled = std::max(d_sampled - obs(3) - radius, 0.f);
+
+        float d_c = base::CollisionAndDistance::distanceCapsuleToSphere(A, B, radius, obs, nearest_pts);
+        ASSERT_NEAR(d_c, d_sampled, 2e-3);
+        ASSERT_EQ(base::CollisionAndDistance::collisionCapsuleToSphere(A, B, radius, obs), d_c == 0);
+        if (d_c > 0)
+        {
+            ASSERT_NEAR((nearest_pts.col(0) - nearest_pts.col(1)).norm(), d_c + radius, 1e-5);
+            ASSERT_NEAR((nearest_pts.col(1) - obs.head(3)).norm(), obs(3), 1e-5);
+        }
+    }
+}
+
+TEST(RealVectorSpaceTest, testCapsuleToOrientedBox)
+{
+    Eigen::VectorXf obs(6), obs_local(6);
+    base::NearestPoints nearest_pts, nearest_pts_oriented;
+    for (size_t i = 0; i < 1000; i++)
+    {
+        Eigen::Vector3f half_dim = 0.05 * Eigen::Vector3f::Ones() + 0.2 * Eigen::Vector3f::Random().cwiseAbs();
+        obs_local << -half_dim, half_dim;
+        Eigen::Vector3f A = Eigen::Vector3f::Random();
+        Eigen::Vector3f B = Eigen::Vector3f::Random();
+        float radius = 0.1 * std::abs(Eigen::VectorXf::Random(1)(0));
+
+        // Rotating and translating both the capsule and the box must not change the result
+        Eigen::Matrix3f R = Eigen::Quaternionf(Eigen::Vector4f::Random()).normalized().toRotationMatrix();
+        Eigen::Vector3f center = Eigen::Vector3f::Random();
+        Eigen::Vector3f A_world = R * A + center;
+        Eigen::Vector3f B_world = R * B + center;
+
+        obs = obs_local;
+        bool collision = base::CollisionAndDistance::collisionCapsuleToBox(A, B, radius, obs);
+        ASSERT_EQ(base::CollisionAndDistance::collisionCapsuleToOrientedBox(A_world, B_world, radius, R, center, obs), collision);
+
+        float d_c = base::CollisionAndDistance::distanceCapsuleToBox(A, B, radius, obs_local, nearest_pts);
+        float d_c_oriented = base::CollisionAndDistance::distanceCapsuleToOrientedBox(A_world, B_world, radius, R, center, 
+                                                                                      obs_local, nearest_pts_oriented);
+        ASSERT_NEAR(d_c_oriented, d_c, 1e-4);
+        if (d_c > 1e-4)
+        {
+            ASSERT_TRUE(nearest_pts_oriented.isApprox((R * nearest_pts).colwise() + center, 1e-3));
+        }
+    }
+}
+
+TEST(RealVectorSpaceTest, testCertifiedEdgeWithDistanceTolerance)
+{
+    // The obstacle is farther from 'q1' than its tolerance, so it is ignored by 'computeDistance', but it lies on the edge
+    std::shared_ptr<robots::AbstractRobot> robot = std::make_shared<Planar1DOFTestRobot>();
+    std::shared_ptr<env::Environment> env = getEmptyEnvironment();
+    std::shared_ptr<env::Object> box = std::make_shared<env::Box>(fcl::Vector3f(0.1, 0.1, 0.1), fcl::Vector3f(0, 0.6, 0), 
+                                                                  fcl::Quaternionf::Identity());
+    box->setMinDistTol(0.1);
+    env->addObject(box);
+    std::shared_ptr<base::StateSpace> ss = std::make_shared<base::RealVectorSpace>(1, robot, env);
+
+    for (bool certified : {false, true})
+    {
+        RealVectorSpaceConfig::CERTIFIED_EDGE_VALIDATION = certified;
+        std::shared_ptr<base::State> q1 = ss->getNewState(Eigen::VectorXf::Constant(1, 0));
+        std::shared_ptr<base::State> q2 = ss->getNewState(Eigen::VectorXf::Constant(1, 2));
+        ASSERT_FALSE(ss->isValid(q1, q2));
+        ASSERT_EQ(q1->getDistance(), certified ? INFINITY : -1);
+        
+        ss->computeDistance(q2, false);     // Both distances are available
+        ASSERT_FALSE(ss->isValid(q1, q2));
+        ASSERT_FALSE(ss->isValid(q2, q1));
+    }
+    RealVectorSpaceConfig::CERTIFIED_EDGE_VALIDATION = false;
+}
+
+TEST(RealVectorSpaceTest, testDistanceLowerBoundIsConservative)
+{
+    // The same boxes are added into 'env', where half of them have a distance tolerance, and into 'env_all' without tolerances
+    std::shared_ptr<robots::AbstractRobot> robot = std::make_shared<Planar1DOFTestRobot>();
+    std::shared_ptr<env::Environment> env = getEmptyEnvironment();
+    std::shared_ptr<env::Environment> env_all = getEmptyEnvironment();
+    for (size_t j = 0; j < 20; j++)
+    {
+        Eigen::Vector3f pos = 2 * Eigen::Vector3f::Random();
+        pos(2) = 0;
+        std::shared_ptr<env::Object> box = std::make_shared<env::Box>(fcl::Vector3f(0.1, 0.1, 0.1), pos, fcl::Quaternionf::Identity());
+        env_all->addObject(std::make_shared<env::Box>(fcl::Vector3f(0.1, 0.1, 0.1), pos, fcl::Quaternionf::Identity()));
+        if (j % 2 == 0)
+            box->setMinDistTol(0.5);
+        env->addObject(box);
+    }
+    std::shared_ptr<base::StateSpace> ss = std::make_shared<base::RealVectorSpace>(1, robot, env);
+    std::shared_ptr<base::StateSpace> ss_all = std::make_shared<base::RealVectorSpace>(1, robot, env_all);
+
+    for (size_t i = 0; i < 100; i++)
+    {
+        std::shared_ptr<base::State> q = ss->getRandomState(nullptr);
+        std::shared_ptr<base::State> q_bound = ss->getNewState(q->getCoord());
+        RealVectorSpaceConfig::USE_DISTANCE_LOWER_BOUND = false;
+        float d_c = ss->computeDistance(q, true);
+        RealVectorSpaceConfig::USE_DISTANCE_LOWER_BOUND = true;
+        ASSERT_EQ(ss->computeDistance(q_bound, true), d_c);
+        if (d_c == 0)
+            continue;
+
+        // Each pair keeps either exact nearest points, or points of a plane separating the link from the box
+        for (size_t j = 0; j < env->getNumObjects(); j++)
+        {
+            const Eigen::MatrixXf &pts = q->getNearestPoints()->at(j);
+            const Eigen::MatrixXf &pts_bound = q_bound->getNearestPoints()->at(j);
+            if (pts_bound != pts)
+            {
+                ASSERT_LE((pts_bound.col(0).head(3) - pts_bound.col(0).tail(3)).norm(), 
+                          (pts.col(0).head(3) - pts.col(0).tail(3)).norm() + 1e-5);
+            }
+        }
+
+        // Distance underestimation in another configuration does not exceed the real distance to all boxes
+        std::shared_ptr<base::State> q_new = ss->getRandomState(nullptr);
+        RealVectorSpaceConfig::USE_DISTANCE_LOWER_BOUND = false;
+        float d_c_all = ss_all->computeDistance(ss_all->getNewState(q_new->getCoord()), true);
+        ASSERT_LE(ss->computeDistanceUnderestimation(q_new, q_bound->getNearestPoints()), d_c_all + 1e-5);
+    }
+    RealVectorSpaceConfig::USE_DISTANCE_LOWER_BOUND = false;
+}
+
+TEST(RealVectorSpaceTest, testObstaclesAreUpdatedForAnotherEnvironment)
+{
+    // Both environments have the same version, but different obstacles
+    std::shared_ptr<env::Environment> env1 = getEmptyEnvironment();
+    std::shared_ptr<env::Environment> env2 = getEmptyEnvironment();
+    env1->addObject(std::make_shared<env::Box>(fcl::Vector3f(0.1, 0.1, 0.1), fcl::Vector3f(0.5, 0, 0), fcl::Quaternionf::Identity()));
+    env2->addObject(std::make_shared<env::Box>(fcl::Vector3f(0.1, 0.1, 0.1), fcl::Vector3f(0, 0.5, 0), fcl::Quaternionf::Identity()));
+    ASSERT_EQ(env1->getVersion(), env2->getVersion());
+
+    std::shared_ptr<base::StateSpace> ss = std::make_shared<base::RealVectorSpace>(1, std::make_shared<Planar1DOFTestRobot>(), env1);
+    std::shared_ptr<base::State> q = ss->getNewState(Eigen::VectorXf::Constant(1, 0));
+    ASSERT_FALSE(ss->isValid(q));
+    ss->env = env2;
+    ASSERT_TRUE(ss->isValid(q));
+}
+
+TEST(RealVectorSpaceTest, testObstaclesAreUpdatedWhenObjectChanges)
+{
+    std::shared_ptr<env::Environment> env = getEmptyEnvironment();
+    std::shared_ptr<env::Object> box = std::make_shared<env::Box>(fcl::Vector3f(0.1, 0.1, 0.1), fcl::Vector3f(0.5, 0, 0), fcl::Quaternionf::Identity());
+    env->addObject(box);
+    std::shared_ptr<robots::AbstractRobot> robot = std::make_shared<Planar1DOFTestRobot>();
+    std::shared_ptr<base::StateSpace> ss = std::make_shared<base::RealVectorSpace>(1, robot, env);
+    std::shared_ptr<base::State> q = ss->getNewState(Eigen::VectorXf::Constant(1, 0));
+    ASSERT_FALSE(ss->isValid(q));
+    box->setPosition(fcl::Vector3f(0, 0.5, 0));
+    ASSERT_TRUE(ss->isValid(q));
+
+    // A copy of the environment has its own objects
+    std::shared_ptr<env::Environment> env_copy = std::make_shared<env::Environment>(env);
+    std::shared_ptr<base::StateSpace> ss_copy = std::make_shared<base::RealVectorSpace>(1, robot, env_copy);
+    box->setPosition(fcl::Vector3f(0.5, 0, 0));
+    ASSERT_FALSE(ss->isValid(q));
+    ASSERT_TRUE(ss_copy->isValid(q));
+    env_copy->getObject(0)->setPosition(fcl::Vector3f(0.5, 0, 0));
+    ASSERT_FALSE(ss_copy->isValid(q));
+}
\ No newline at end of file
@@ -2,6 +2,8 @@
 // Created by dinko on 28.5.21..
 //
 #include "RealVectorSpaceState.h"
+#include "StatePool.h"
+#include "KinematicsCache.h"
 #include <Eigen/Dense>
 
 
@@ -22,3 +24,89 @@ TEST(RealVectorSpaceStateTest, testConstructor1)
     ASSERT_EQ(q->getNumDimensions(), 6);
     ASSERT_EQ(q->getCoord(), state_coord);
 }
+
+TEST(RealVectorSpaceStateTest, testStatePool)
+{
+    std::shared_ptr<base::StatePool> pool = std::make_shared<base::StatePool>(4);
+    base::StatePoolAllocator<base::RealVectorSpaceState> allocator(pool);
+    std::vector<std::shared_ptr<base::State>> qs {};
+    for (size_t i = 0; i < 10; i++)
+        qs.emplace_back(std::allocate_shared<base::RealVectorSpaceState>(allocator, Eigen::Vector3f::Constant(i)));
+
+    ASSERT_EQ(pool->getNumBlocks(), 10);
+    ASSERT_EQ(pool->getNumChunks(), 3);
+
+    // Freed blocks are reused
+    qs.resize(5);
+    qs.emplace_back(std::allocate_shared<base::RealVectorSpaceState>(allocator, Eigen::Vector3f::Constant(10)));
+    ASSERT_EQ(pool->getNumBlocks(), 6);
+    ASSERT_EQ(pool->getNumChunks(), 3);
+
+    // States remain valid after the pool is released by its owner
+    allocator = base::StatePoolAllocator<base::RealVectorSpaceState>(nullptr);
+    pool = nullptr;
+    for (size_t i = 0; i < 5; i++)
+        ASSERT_EQ(qs[i]->getCoord(), Eigen::Vector3f::Constant(i));
+    ASSERT_EQ(qs[5]->getCoord(), Eigen::Vector3f::Constant(10));
+}
+
+
+TEST(RealVectorSpaceStateTest, testKinematicsCache)
+{
+    // Each skeleton takes the same size, so the cache can hold quantities of exactly three states
+    const size_t skeleton_size = sizeof(Eigen::MatrixXf) + 3 * 7 * sizeof(float);
+    base::KinematicsCache cache(3 * skeleton_size);
+    std::vector<std::shared_ptr<base::State>> qs {};
+    for (size_t i = 0; i < 4; i++)
+    {
+        qs.emplace_back(std::make_shared<base::RealVectorSpaceState>(Eigen::Vector3f::Constant(i)));
+        qs.back()->setSkeleton(std::make_shared<Eigen::MatrixXf>(Eigen::MatrixXf::Constant(3, 7, i)));
+        cache.miss(qs.back());
+        if (i == 2)
+            cache.hit(qs[0]);      // 'qs[0]' is used again, so 'qs[1]' becomes the least recently used
+    }
+
+    ASSERT_EQ(cache.getNumHits(), 1);
+    ASSERT_EQ(cache.getNumMisses(), 4);
+    ASSERT_EQ(cache.getNumEvictions(), 1);
+    ASSERT_EQ(cache.getNumEntries(), 3);
+    ASSERT_EQ(cache.getSize(), 3 * skeleton_size);
+    ASSERT_TRUE(qs[0]->getSkeleton() != nullptr);
+    ASSERT_TRUE(qs[1]->getSkeleton() == nullptr);
+    ASSERT_TRUE(qs[2]->getSkeleton() != nullptr);
+    ASSERT_TRUE(qs[3]->getSkeleton() != nullptr);
+
+    // A destroyed state leaves the cache at once, so a new state fits without releasing living states
+    qs[2] = nullptr;
+    ASSERT_EQ(cache.getNumEntries(), 2);
+    ASSERT_EQ(cache.getSize(), 2 * skeleton_size);
+    qs.emplace_back(std::make_shared<base::RealVectorSpaceState>(Eigen::Vector3f::Constant(4)));
+    qs.back()->setSkeleton(std::make_shared<Eigen::MatrixXf>(Eigen::MatrixXf::Constant(3, 7, 4)));
+    cache.miss(qs.back());
+    ASSERT_EQ(cache.getNumEvictions(), 1);
+    ASSERT_TRUE(qs[0]->getSkeleton() != nullptr);
+    ASSERT_TRUE(qs[3]->getSkeleton() != nullptr);
+
+    cache.clear();
+    ASSERT_EQ(cache.getSize(), 0);
+    ASSERT_TRUE(qs[0]->getSkeleton() == nullptr);
+
+    // Pooled states are tracked in the same way, and states may outlive the cache
+    std::shared_ptr<base::StatePool> pool = std::make_shared<base::StatePool>(4);
+    std::shared_ptr<base::KinematicsCache> cache_pooled = std::make_shared<base::KinematicsCache>(3 * skeleton_size);
+    for (size_t i = 0; i < 10; i++)
+    {
+        std::shared_ptr<base::State> q = std::allocate_shared<base::RealVectorSpaceState>
+            (base::StatePoolAllocator<base::RealVectorSpaceState>(pool), Eigen::Vector3f::Constant(i));
+        q->setSkeleton(std::make_shared<Eigen::MatrixXf>(Eigen::MatrixXf::Constant(3, 7, i)));
+        cache_pooled->miss(q);
+        ASSERT_EQ(cache_pooled->getNumEntries(), 1);
+        if (i == 9)
+            qs[0] = q;
+    }
+    ASSERT_EQ(pool->getNumBlocks(), 1);
+    ASSERT_EQ(cache_pooled->getNumEvictions(), 0);
+    cache_pooled = nullptr;
+    ASSERT_TRUE(qs[0]->getKinematicsCache() == nullptr);
+    ASSERT_TRUE(qs[0]->getSkeleton() != nullptr);
+}
\ No newline at end of file
@@ -0,0 +1,214 @@
+#include "Tree.h"
+#include "RealVectorSpaceState.h"
+#include <Eigen/Dense>
+
+// Build a tree of 'num_states' random 3D states, where each state is connected to its nearest state
+std::shared_ptr<base::Tree> buildRandomTree(size_t num_states, bool contiguous_storage, 
+                                            const Eigen::VectorXf &metric_weights = Eigen::VectorXf())
+{
+    const bool contiguous_storage_prev = TreeConfig::CONTIGUOUS_STORAGE;
+    TreeConfig::CONTIGUOUS_STORAGE = contiguous_storage;
+    std::srand(0);
+    std::shared_ptr<base::Tree> tree = std::make_shared<base::Tree>("test", 0);
+    tree->setMetricWeights(metric_weights);
+    tree->upgradeTree(std::make_shared<base::RealVectorSpaceState>(Eigen::Vector3f::Random()), nullptr);
+    for (size_t i = 1; i < num_states; i++)
+    {
+        std::shared_ptr<base::State> q = std::make_shared<base::RealVectorSpaceState>(Eigen::Vector3f::Random());
+        q->setCost(i);
+        tree->upgradeTree(q, tree->getNearestState(q));
+    }
+    TreeConfig::CONTIGUOUS_STORAGE = contiguous_storage_prev;
+    return tree;
+}
+
+TEST(TreeTest, testContiguousStorage)
+{
+    std::shared_ptr<base::Tree> tree = buildRandomTree(200, true);
+
+    ASSERT_TRUE(tree->getContiguousStorage());
+    for (size_t i = 0; i < tree->getNumStates(); i++)
+    {
+        std::shared_ptr<base::State> q = tree->getState(i);
+        ASSERT_EQ(Eigen::Map<const Eigen::Vector3f>(tree->getCoordData(i)), q->getCoord());
+        ASSERT_EQ(tree->getParentIdx(i), q->getParent() == nullptr ? -1 : long(q->getParent()->getIdx()));
+    }
+}
+
+TEST(TreeTest, testStorageLayoutsAreEquivalent)
+{
+    std::shared_ptr<base::Tree> tree1 = buildRandomTree(200, false);
+    std::shared_ptr<base::Tree> tree2 = buildRandomTree(200, true);
+
+    for (size_t i = 0; i < 50; i++)
+    {
+        std::shared_ptr<base::State> q = std::make_shared<base::RealVectorSpaceState>(Eigen::Vector3f::Random());
+        size_t idx = tree1->getNearestState2(q)->getIdx();
+        ASSERT_EQ(idx, tree2->getNearestState2(q)->getIdx());
+        ASSERT_EQ(idx, tree1->getNearestState(q)->getIdx());
+
+        std::vector<std::shared_ptr<base::State>> path1 = tree1->computePathToRoot(idx);
+        std::vector<std::shared_ptr<base::State>> path2 = tree2->computePathToRoot(idx);
+        ASSERT_EQ(path1.size(), path2.size());
+        for (size_t j = 0; j < path1.size(); j++)
+            ASSERT_EQ(path1[j]->getCoord(), path2[j]->getCoord());
+    }
+}
+
+TEST(TreeTest, testPathsToRootAreEquivalent)
+{
+    std::shared_ptr<base::Tree> tree1 = buildRandomTree(200, false);
+    std::shared_ptr<base::Tree> tree2 = buildRandomTree(200, true);
+
+    // The root of each tree gets a parent which does not belong to the tree (e.g., a state from the opposite tree), 
+    // and some states are rewired to the root
+    std::shared_ptr<base::State> q_outside = std::make_shared<base::RealVectorSpaceState>(Eigen::Vector3f::Zero());
+    for (std::shared_ptr<base::Tree> tree : {tree1, tree2})
+    {
+        tree->getState(0)->setParent(q_outside);
+        tree->refreshState(0);
+        for (size_t i = 10; i < tree->getNumStates(); i += 10)
+        {
+            tree->getState(i)->setParent(tree->getState(0));
+            tree->refreshState(i);
+        }
+    }
+
+    for (size_t idx = 0; idx < tree1->getNumStates(); idx++)
+    {
+        std::vector<std::shared_ptr<base::State>> path1 = tree1->computePathToRoot(idx);
+        std::vector<std::shared_ptr<base::State>> path2 = tree2->computePathToRoot(idx);
+        ASSERT_EQ(path1.size(), path2.size());
+        for (size_t j = 0; j < path1.size(); j++)
+            ASSERT_EQ(path1[j]->getIdx(), path2[j]->getIdx());
+        ASSERT_EQ(path1.back(), tree1->getState(0));
+        ASSERT_EQ(path2.back(), tree2->getState(0));
+    }
+}
+
+TEST(TreeTest, testBatchedQueries)
+{
+    std::shared_ptr<base::Tree> tree = buildRandomTree(500, true);
+    std::vector<std::shared_ptr<base::State>> qs {};
+    for (size_t i = 0; i < 20; i++)
+        qs.emplace_back(std::make_shared<base::RealVectorSpaceState>(Eigen::Vector3f::Random()));
+
+    const size_t k = 5;
+    const float r = 0.3;
+    std::vector<std::vector<std::shared_ptr<base::State>>> q_nearest = tree->getKNearestStates(qs, k);
+    std::vector<std::vector<std::shared_ptr<base::State>>> q_within = tree->getStatesWithinRadius(qs, r);
+    ASSERT_EQ(q_nearest.size(), qs.size());
+    ASSERT_EQ(q_within.size(), qs.size());
+
+    for (size_t i = 0; i < qs.size(); i++)
+    {
+        // Brute-force reference
+        std::vector<std::pair<float, size_t>> dists {};
+        for (size_t j = 0; j < tree->getNumStates(); j++)
+            dists.emplace_back((tree->getState(j)->getCoord() - qs[i]->getCoord()).norm(), j);
+        std::sort(dists.begin(), dists.end());
+
+        ASSERT_EQ(q_nearest[i].size(), k);
+        for (size_t j = 0; j < k; j++)
+            ASSERT_EQ(q_nearest[i][j]->getIdx(), dists[j].second);
+
+        size_t num_within = 0;
+        while (num_within < dists.size() && dists[num_within].first <= r)
+            num_within++;
+        ASSERT_EQ(q_within[i].size(), num_within);
+    }
+
+    std::vector<std::vector<std::shared_ptr<base::State>>> q_nearest_parallel = tree->getKNearestStates(qs, k, true);
+    for (size_t i = 0; i < qs.size(); i++)
+        ASSERT_EQ(q_nearest_parallel[i], q_nearest[i]);
+}
+
+TEST(TreeTest, testStaticKdTreeIsExact)
+{
+    TreeConfig::STATIC_KD_TREE_THRESHOLD = 100;
+    TreeConfig::KD_TREE_BUFFER_SIZE = 50;
+    std::shared_ptr<base::Tree> tree = buildRandomTree(1000, false);
+
+    // Wait for the static Kd-tree being built in the background
+    tree->waitForRebuild();
+    TreeConfig::STATIC_KD_TREE_THRESHOLD = 0;
+    TreeConfig::KD_TREE_BUFFER_SIZE = 1000;
+
+    ASSERT_EQ(tree->getKdTree(), nullptr);  // Dynamic Kd-tree is replaced by the static one
+    for (size_t i = 0; i < 100; i++)
+    {
+        std::shared_ptr<base::State> q = std::make_shared<base::RealVectorSpaceState>(Eigen::Vector3f::Random());
+        ASSERT_EQ(tree->getNearestState(q)->getIdx(), tree->getNearestState2(q)->getIdx());
+    }
+}
+
+TEST(TreeTest, testLinearSearch)
+{
+    TreeConfig::LINEAR_SEARCH_THRESHOLD = 50;
+    for (bool contiguous_storage : {false, true})
+    {
+        std::shared_ptr<base::Tree> tree = buildRandomTree(50, contiguous_storage);
+        ASSERT_EQ(tree->getKdTree(), nullptr);  // Kd-tree is not built for small trees
+
+        std::vector<std::shared_ptr<base::State>> qs {};
+        for (size_t i = 0; i < 50; i++)
+        {
+            std::shared_ptr<base::State> q = std::make_shared<base::RealVectorSpaceState>(Eigen::Vector3f::Random());
+            ASSERT_EQ(tree->getNearestState(q)->getIdx(), tree->getNearestState2(q)->getIdx());
+            qs.emplace_back(q);
+        }
+        std::vector<std::vector<std::shared_ptr<base::State>>> q_nearest = tree->getKNearestStates(qs, 1);
+        for (size_t i = 0; i < qs.size(); i++)
+            ASSERT_EQ(q_nearest[i].front(), tree->getNearestState2(qs[i]));
+
+        // The Kd-tree is built containing all nodes when the tree outgrows the threshold
+        std::shared_ptr<base::State> q_new = std::make_shared<base::RealVectorSpaceState>(Eigen::Vector3f::Random());
+        tree->upgradeTree(q_new, tree->getNearestState(q_new));
+        ASSERT_NE(tree->getKdTree(), nullptr);
+        for (std::shared_ptr<base::State> q : qs)
+            ASSERT_EQ(tree->getNearestState(q)->getIdx(), tree->getNearestState2(q)->getIdx());
+        ASSERT_EQ(tree->getNearestState(q_new), q_new);
+    }
+    TreeConfig::LINEAR_SEARCH_THRESHOLD = 0;
+}
+
+TEST(TreeTest, testWeightedMetric)
+{
+    const Eigen::Vector3f metric_weights(2, 1, 0.25);
+    for (size_t threshold : {0, 100})   // Kd-tree and linear search
+    {
+        TreeConfig::LINEAR_SEARCH_THRESHOLD = threshold;
+        std::shared_ptr<base::Tree> tree = buildRandomTree(100, true, metric_weights);
+        TreeConfig::LINEAR_SEARCH_THRESHOLD = 0;
+
+        for (size_t i = 0; i < 50; i++)
+        {
+            std::shared_ptr<base::State> q = std::make_shared<base::RealVectorSpaceState>(Eigen::Vector3f::Random());
+            std::vector<std::pair<float, size_t>> dists {};     // Brute-force reference
+            for (size_t j = 0; j < tree->getNumStates(); j++)
+                dists.emplace_back((tree->getState(j)->getCoord() - q->getCoord()).cwiseProduct(metric_weights).norm(), j);
+            std::sort(dists.begin(), dists.end());
+
+            ASSERT_EQ(tree->getNearestState(q)->getIdx(), dists.front().second);
+            ASSERT_EQ(tree->getNearestState2(q)->getIdx(), dists.front().second);
+            std::vector<std::shared_ptr<base::State>> q_nearest = tree->getKNearestStates({q}, 5).front();
+            for (size_t j = 0; j < q_nearest.size(); j++)
+                ASSERT_EQ(q_nearest[j]->getIdx(), dists[j].second);
+        }
+    }
+}
+
+TEST(TreeTest, testApproximateSearch)
+{
+    std::shared_ptr<base::Tree> tree = buildRandomTree(1000, true);
+    const float eps = 1;
+    tree->setApproxEps(eps);
+
+    for (size_t i = 0; i < 100; i++)
+    {
+        std::shared_ptr<base::State> q = std::make_shared<base::RealVectorSpaceState>(Eigen::Vector3f::Random());
+        float d_approx = (tree->getNearestState(q)->getCoord() - q->getCoord()).norm();
+        float d_exact = (tree->getNearestState2(q)->getCoord() - q->getCoord()).norm();
+        ASSERT_LE(d_approx, (1 + eps) * d_exact + 1e-6);
+    }
+}
\ No newline at end of file